@@ -0,0 +1,173 @@
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gundam/io/csvgraph.h"
+
+#include "gundam/graph_type/large_graph.h"
+#include "gundam/graph_type/large_graph2.h"
+#include "gundam/algorithm/dp_iso.h"
+#include "gundam/algorithm/dp_iso_parallel.h"
+
+// wall time, the cpu time from clock() grows with the number of threads
+inline uint64_t GetTime() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+template <class QueryGraph, class TargetGraph>
+int DPISO_Recursive_Run(QueryGraph &query_graph, TargetGraph &target_graph,
+                        int thread_num) {
+  using namespace GUNDAM;
+  using  QueryVertexHandle = typename VertexHandle<QueryGraph>::type;
+  using TargetVertexHandle = typename VertexHandle<TargetGraph>::type;
+  using MatchMap = std::map<QueryVertexHandle, TargetVertexHandle>;
+
+  omp_set_num_threads(thread_num);
+  auto match_callback = [](const MatchMap &match_map) { return true; };
+  return DPISO<MatchSemantics::kIsomorphism>(query_graph, target_graph,
+                                             match_callback, -1.0);
+}
+
+template <class QueryGraph, class TargetGraph>
+int DPISO_Parallel_Run(QueryGraph &query_graph, TargetGraph &target_graph,
+                       int thread_num) {
+  using namespace GUNDAM;
+  using  QueryVertexHandle = typename VertexHandle<QueryGraph>::type;
+  using TargetVertexHandle = typename VertexHandle<TargetGraph>::type;
+  using MatchMap = std::map<QueryVertexHandle, TargetVertexHandle>;
+
+  auto match_callback = [](const MatchMap &match_map) { return true; };
+  return DPISO_Parallel<MatchSemantics::kIsomorphism>(
+      query_graph, target_graph, match_callback, thread_num, -1.0);
+}
+
+struct CSVGraphInfo {
+  std::vector<std::string> vertex_files;
+  std::vector<std::string> edge_files;
+};
+
+struct ParallelMatchBenchmarkConfigure {
+  std::string work_dir;
+  CSVGraphInfo target_graph_info;
+  std::vector<CSVGraphInfo> query_graph_info_list;
+  std::vector<int> thread_num_list;
+};
+
+template <class QueryGraph, class TargetGraph>
+int ParallelMatchBenchmark() {
+  int result;
+  ParallelMatchBenchmarkConfigure config;
+  std::vector<QueryGraph> query_graph_list;
+  TargetGraph target_graph;
+
+  std::cout << "Parallel Match Benchmark" << std::endl;
+
+  // Init config;
+  config.work_dir = "/share/work/";
+  config.thread_num_list = {1, 2, 4, 8, 16, 32, 64};
+
+  for (const auto &pattern : {"pattern_1",  "pattern_11", "pattern_12",
+                              "pattern_43", "pattern_44", "pattern_45"}) {
+    config.query_graph_info_list.emplace_back();
+    config.query_graph_info_list.back().vertex_files.emplace_back(
+        config.work_dir + "match_benchmark/" + pattern + "_n.csv");
+    config.query_graph_info_list.back().edge_files.emplace_back(
+        config.work_dir + "match_benchmark/" + pattern + "_e.csv");
+  }
+
+  config.target_graph_info.vertex_files.emplace_back(config.work_dir +
+                                                     "cu4999_1/liantong_v.csv");
+  config.target_graph_info.edge_files.emplace_back(config.work_dir +
+                                                   "cu4999_1/liantong_e.csv");
+
+  // Loading graphs
+  auto begin_time = GetTime();
+  std::cout << std::endl << "Loading query graph..." << std::endl;
+  for (size_t i = 0; i < config.query_graph_info_list.size(); ++i) {
+    const auto &info = config.query_graph_info_list[i];
+    query_graph_list.emplace_back();
+    std::cout << "Query #" << (i + 1) << std::endl;
+    result = GUNDAM::ReadCSVGraph(query_graph_list.back(), info.vertex_files,
+                                  info.edge_files);
+    if (result < 0) {
+      return result;
+    }
+  }
+
+  std::cout << std::endl << "Loading target graph..." << std::endl;
+  result =
+      GUNDAM::ReadCSVGraph(target_graph, config.target_graph_info.vertex_files,
+                           config.target_graph_info.edge_files);
+  if (result < 0) {
+    return result;
+  }
+
+  std::cout << "Load time: " << GetTime() - begin_time << " ms" << std::endl;
+
+  // Match
+  std::cout << std::endl << "Matcing..." << std::endl;
+  for (size_t i = 0; i < query_graph_list.size(); ++i) {
+    std::cout << "Query #" << (i + 1) << std::endl;
+    auto &query_graph = query_graph_list[i];
+    uint64_t recursive_base_time = 0,
+              parallel_base_time = 0;
+    for (const auto &thread_num : config.thread_num_list) {
+      begin_time = GetTime();
+      int recursive_result
+        = DPISO_Recursive_Run(query_graph, target_graph, thread_num);
+      uint64_t recursive_time = GetTime() - begin_time;
+
+      begin_time = GetTime();
+      int parallel_result
+        = DPISO_Parallel_Run(query_graph, target_graph, thread_num);
+      uint64_t parallel_time = GetTime() - begin_time;
+
+      if (thread_num == config.thread_num_list.front()) {
+        recursive_base_time = recursive_time;
+         parallel_base_time =  parallel_time;
+      }
+      std::cout << "  Threads: " << thread_num << std::endl
+                << "    DPISO_Recursive: " << recursive_result << " results "
+                << recursive_time << " ms speedup "
+                << (double)recursive_base_time / std::max(recursive_time,
+                                                          (uint64_t)1)
+                << std::endl
+                << "     DPISO_Parallel: " << parallel_result << " results "
+                << parallel_time << " ms speedup "
+                << (double)parallel_base_time / std::max(parallel_time,
+                                                         (uint64_t)1)
+                << std::endl;
+      if (recursive_result != parallel_result) {
+        std::cout << "Result mismatch!" << std::endl;
+        return -1;
+      }
+    }
+    std::cout << std::endl;
+  }
+  return 0;
+}
+
+int main() {
+  using namespace GUNDAM;
+
+  using LGQ = LargeGraph<uint32_t, uint32_t, std::string, uint32_t, uint32_t,
+                         std::string>;
+
+  using LGT = LargeGraph<uint64_t, uint32_t, std::string, uint64_t, uint32_t,
+                         std::string>;
+
+  using LGT2 = LargeGraph2<uint64_t, uint32_t, std::string, uint64_t, uint32_t,
+                           std::string>;
+
+  std::cout << "Case 1: LGQ, LGT" << std::endl;
+  ParallelMatchBenchmark<LGQ, LGT>();
+
+  std::cout << "Case 2: LGQ, LGT2" << std::endl;
+  ParallelMatchBenchmark<LGQ, LGT2>();
+
+  return 0;
+}
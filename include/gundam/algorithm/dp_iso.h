@@ -970,6 +970,852 @@ bool _DPISO(
   return true;
 }
 
+// flat match state used in the inner recursion of DPISO
+//
+// the query vertexes are indexed densely in the order of the
+// candidate set, the matched target vertexes are held in an
+// array indexed by the query vertex and (for isomorphism) in a
+// small open-addressing set. the candidate sets are narrowed
+// in place, the replaced ones are kept on an undo trail and
+// swapped back when backtracking, so that neither the match
+// state nor the candidate set need to be copied or allocated
+// at each search node.
+//
+// the match map handed to the user/prune callbacks is the
+// same as in _DPISO, it is only built when a callback needs it
+template <enum MatchSemantics match_semantics, 
+          typename  QueryGraph,
+          typename TargetGraph>
+class FlatMatchState {
+ public:
+  using  QueryVertexHandle = typename VertexHandle< QueryGraph>::type;
+  using TargetVertexHandle = typename VertexHandle<TargetGraph>::type;
+
+  using IndexType = uint32_t;
+
+  using CandidateContainer = std::vector<TargetVertexHandle>;
+
+  using CandidateSetContainer = std::map<QueryVertexHandle, 
+                                         CandidateContainer>;
+
+  using MatchMap = std::map<QueryVertexHandle, TargetVertexHandle>;
+
+  static constexpr IndexType kNoIndex = std::numeric_limits<IndexType>::max();
+
+ private:
+  using  QueryEdgeLabelType = typename  QueryGraph::EdgeType::LabelType;
+  using    TargetEdgeIDType = typename TargetGraph::EdgeType::IDType;
+  using TargetVertexIDType  = typename TargetGraph::VertexType::IDType;
+
+  struct AdjEdge {
+    QueryEdgeLabelType label;
+    IndexType adj_idx;
+  };
+
+  // set of the matched target vertexes, open addressing with 
+  // linear probing, holds at most as many vertexes as the query
+  class TargetMatchedSet {
+   public:
+    void Init(size_t max_size) {
+      size_t capacity = 4;
+      while (capacity < max_size * 2) {
+        capacity <<= 1;
+      }
+      slot_.assign(capacity, TargetVertexHandle());
+      occupied_.assign(capacity, false);
+      mask_ = capacity - 1;
+      return;
+    }
+
+    inline bool Contains(const TargetVertexHandle &target_vertex_handle) const {
+      for (size_t pos = this->Hash(target_vertex_handle);; 
+                  pos = (pos + 1) & mask_) {
+        if (!occupied_[pos]) {
+          return false;
+        }
+        if (slot_[pos] == target_vertex_handle) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    inline void Insert(const TargetVertexHandle &target_vertex_handle) {
+      size_t pos = this->Hash(target_vertex_handle);
+      while (occupied_[pos]) {
+        assert(!(slot_[pos] == target_vertex_handle));
+        pos = (pos + 1) & mask_;
+      }
+      slot_[pos] = target_vertex_handle;
+      occupied_[pos] = true;
+      return;
+    }
+
+    inline void Erase(const TargetVertexHandle &target_vertex_handle) {
+      size_t pos = this->Hash(target_vertex_handle);
+      while (!(slot_[pos] == target_vertex_handle)) {
+        assert(occupied_[pos]);
+        pos = (pos + 1) & mask_;
+      }
+      // backward shift the following slots instead of tombstones
+      size_t next_pos = pos;
+      while (true) {
+        next_pos = (next_pos + 1) & mask_;
+        if (!occupied_[next_pos]) {
+          break;
+        }
+        size_t home = this->Hash(slot_[next_pos]);
+        // whether home is cyclically in (pos, next_pos]
+        bool stay = (pos <= next_pos) ? (pos < home && home <= next_pos)
+                                      : (pos < home || home <= next_pos);
+        if (stay) {
+          continue;
+        }
+        slot_[pos] = slot_[next_pos];
+        pos = next_pos;
+      }
+      occupied_[pos] = false;
+      slot_[pos] = TargetVertexHandle();
+      return;
+    }
+
+   private:
+    inline size_t Hash(const TargetVertexHandle &target_vertex_handle) const {
+      uint64_t hash = std::hash<TargetVertexIDType>()(target_vertex_handle->id());
+      return (hash * 0x9E3779B97F4A7C15ull >> 17) & mask_;
+    }
+
+    std::vector<TargetVertexHandle> slot_;
+    std::vector<bool> occupied_;
+    size_t mask_ = 0;
+  };
+
+ public:
+  FlatMatchState(const CandidateSetContainer &candidate_set,
+                 const MatchMap &match_state) 
+                   : matched_count_(0),
+                     match_map_outdated_(true) {
+    query_handle_.reserve(candidate_set.size());
+    candidate_.reserve(candidate_set.size());
+    for (const auto &[query_vertex_handle, 
+                      query_vertex_candidate] : candidate_set) {
+      query_handle_.emplace_back(query_vertex_handle);
+      candidate_.emplace_back(query_vertex_candidate);
+    }
+    const size_t kQuerySize = query_handle_.size();
+    match_.resize(kQuerySize, TargetVertexHandle());
+    is_matched_.resize(kQuerySize, false);
+    in_edge_.resize(kQuerySize);
+    out_edge_.resize(kQuerySize);
+    adj_.resize(kQuerySize);
+    parent_.resize(kQuerySize);
+    has_parent_.resize(kQuerySize, false);
+    if constexpr (match_semantics == MatchSemantics::kIsomorphism) {
+      target_matched_.Init(kQuerySize);
+    }
+
+    for (IndexType idx = 0; idx < kQuerySize; idx++) {
+      for (auto edge_it = query_handle_[idx]->OutEdgeBegin();
+               !edge_it.IsDone();
+                edge_it++) {
+        IndexType adj_idx = this->FindIndex(edge_it->dst_handle());
+        if (adj_idx == kNoIndex) {
+          continue;
+        }
+        out_edge_[idx].push_back(AdjEdge{edge_it->label(), adj_idx});
+        adj_[idx].push_back(adj_idx);
+      }
+      for (auto edge_it = query_handle_[idx]->InEdgeBegin();
+               !edge_it.IsDone();
+                edge_it++) {
+        IndexType adj_idx = this->FindIndex(edge_it->src_handle());
+        if (adj_idx == kNoIndex) {
+          continue;
+        }
+        in_edge_[idx].push_back(AdjEdge{edge_it->label(), adj_idx});
+        adj_[idx].push_back(adj_idx);
+      }
+      std::sort(adj_[idx].begin(), adj_[idx].end());
+      adj_[idx].erase(std::unique(adj_[idx].begin(), adj_[idx].end()),
+                      adj_[idx].end());
+    }
+
+    for (const auto &[query_vertex_handle, 
+                     target_vertex_handle] : match_state) {
+      IndexType idx = this->FindIndex(query_vertex_handle);
+      assert(idx != kNoIndex);
+      this->UpdateState(idx, target_vertex_handle);
+    }
+  }
+
+  inline size_t size() const { return query_handle_.size(); }
+
+  inline size_t matched_count() const { return matched_count_; }
+
+  inline bool IsMatched(IndexType idx) const { return is_matched_[idx]; }
+
+  inline const TargetVertexHandle &MatchTo(IndexType idx) const {
+    assert(is_matched_[idx]);
+    return match_[idx];
+  }
+
+  inline const CandidateContainer &Candidate(IndexType idx) const {
+    return candidate_[idx];
+  }
+
+  inline const QueryVertexHandle &QueryHandle(IndexType idx) const {
+    return query_handle_[idx];
+  }
+
+  inline IndexType FindIndex(const QueryVertexHandle &query_vertex_handle) const {
+    auto it = std::lower_bound(query_handle_.begin(),
+                               query_handle_.end(), query_vertex_handle);
+    if (it == query_handle_.end() || !(*it == query_vertex_handle)) {
+      return kNoIndex;
+    }
+    return it - query_handle_.begin();
+  }
+
+  // same strategy as NextMatchVertex: the not matched vertex
+  // adjacent to the matched ones with fewest candidates,
+  // all not matched vertexes are considered if there are none
+  inline IndexType NextMatchVertex() const {
+    IndexType res = kNoIndex;
+    size_t min = std::numeric_limits<size_t>::max();
+    for (int consider_all = 0; consider_all < 2; consider_all++) {
+      for (IndexType idx = 0; idx < query_handle_.size(); idx++) {
+        if (is_matched_[idx]) {
+          continue;
+        }
+        if (!consider_all && !this->HasMatchedAdj(idx)) {
+          continue;
+        }
+        if (candidate_[idx].size() < min) {
+          res = idx;
+          min = candidate_[idx].size();
+        }
+      }
+      if (res != kNoIndex) {
+        break;
+      }
+    }
+    return res;
+  }
+
+  inline bool IsJoinable(IndexType idx, 
+         const TargetVertexHandle &target_vertex_handle) {
+    if constexpr (match_semantics == MatchSemantics::kIsomorphism) {
+      if (target_matched_.Contains(target_vertex_handle)) {
+        return false;
+      }
+    }
+    if (!this->template JoinableCheck<EdgeDirection::kIn>(
+                                      idx, target_vertex_handle)) {
+      return false;
+    }
+    if (!this->template JoinableCheck<EdgeDirection::kOut>(
+                                      idx, target_vertex_handle)) {
+      return false;
+    }
+    return true;
+  }
+
+  inline void UpdateState(IndexType idx,
+              const TargetVertexHandle &target_vertex_handle) {
+    assert(!is_matched_[idx]);
+    match_[idx] = target_vertex_handle;
+    is_matched_[idx] = true;
+    matched_count_++;
+    match_map_outdated_ = true;
+    if constexpr (match_semantics == MatchSemantics::kIsomorphism) {
+      target_matched_.Insert(target_vertex_handle);
+    }
+    return;
+  }
+
+  inline void RestoreState(IndexType idx) {
+    assert(is_matched_[idx]);
+    if constexpr (match_semantics == MatchSemantics::kIsomorphism) {
+      target_matched_.Erase(match_[idx]);
+    }
+    match_[idx] = TargetVertexHandle();
+    is_matched_[idx] = false;
+    matched_count_--;
+    match_map_outdated_ = true;
+    return;
+  }
+
+  // narrow the candidate sets of the not matched vertexes adjacent
+  // to idx, returns false if one of them becomes empty
+  inline bool UpdateCandidateSet(IndexType idx, 
+                     TargetVertexHandle target_vertex_handle) {
+    bool all_not_empty = true;
+    if (!this->template UpdateCandidateSetOneDirection<EdgeDirection::kIn>(
+                                                   idx, target_vertex_handle)) {
+      all_not_empty = false;
+    }
+    if (!this->template UpdateCandidateSetOneDirection<EdgeDirection::kOut>(
+                                                   idx, target_vertex_handle)) {
+      all_not_empty = false;
+    }
+    return all_not_empty;
+  }
+
+  // marker to restore the candidate set to
+  inline size_t TrailSize() const { return trail_.size(); }
+
+  inline void RestoreCandidateSet(size_t trail_size) {
+    while (trail_.size() > trail_size) {
+      auto &[idx, candidate] = trail_.back();
+      spare_.emplace_back(std::move(candidate_[idx]));
+      candidate_[idx] = std::move(candidate);
+      trail_.pop_back();
+    }
+    return;
+  }
+
+  // parents and fail sets are held as sorted index vectors,
+  // same as UpdateParent but on the dense index
+  inline void UpdateParent(IndexType idx) {
+    assert(!has_parent_[idx]);
+    auto &parent = parent_[idx];
+    parent.clear();
+    parent.emplace_back(idx);
+    for (const auto &adj_edge : in_edge_[idx]) {
+      this->AppendParent(parent, adj_edge.adj_idx);
+    }
+    for (const auto &adj_edge : out_edge_[idx]) {
+      this->AppendParent(parent, adj_edge.adj_idx);
+    }
+    std::sort(parent.begin(), parent.end());
+    parent.erase(std::unique(parent.begin(), parent.end()), parent.end());
+    has_parent_[idx] = true;
+    return;
+  }
+
+  inline void EraseParent(IndexType idx) {
+    assert(has_parent_[idx]);
+    has_parent_[idx] = false;
+    return;
+  }
+
+  inline const std::vector<IndexType> &Parent(IndexType idx) const {
+    assert(has_parent_[idx]);
+    return parent_[idx];
+  }
+
+  // the query vertex matched to target_vertex_handle
+  inline IndexType MatchedBy(const TargetVertexHandle &target_vertex_handle) const {
+    for (IndexType idx = 0; idx < query_handle_.size(); idx++) {
+      if (is_matched_[idx] && match_[idx] == target_vertex_handle) {
+        return idx;
+      }
+    }
+    return kNoIndex;
+  }
+
+  inline bool IsTargetMatched(const TargetVertexHandle &target_vertex_handle) const {
+    if constexpr (match_semantics == MatchSemantics::kIsomorphism) {
+      return target_matched_.Contains(target_vertex_handle);
+    }
+    return this->MatchedBy(target_vertex_handle) != kNoIndex;
+  }
+
+  // build the match map in the form of _DPISO, the query handles
+  // are held in the order of the map so the entries can be
+  // updated in place without reallocating the tree nodes
+  inline MatchMap &match_map() {
+    if (!match_map_outdated_) {
+      return match_map_;
+    }
+    auto map_it = match_map_.begin();
+    for (IndexType idx = 0; idx < query_handle_.size(); idx++) {
+      while (map_it != match_map_.end() 
+          && map_it->first < query_handle_[idx]) {
+        map_it = match_map_.erase(map_it);
+      }
+      const bool kInMap = map_it != match_map_.end() 
+                      && map_it->first == query_handle_[idx];
+      if (!is_matched_[idx]) {
+        if (kInMap) {
+          map_it = match_map_.erase(map_it);
+        }
+        continue;
+      }
+      if (kInMap) {
+        map_it->second = match_[idx];
+        map_it++;
+        continue;
+      }
+      map_it = std::next(match_map_.emplace_hint(map_it, query_handle_[idx],
+                                                            match_[idx]));
+    }
+    match_map_.erase(map_it, match_map_.end());
+    match_map_outdated_ = false;
+    return match_map_;
+  }
+
+  // the callbacks might have modified the match map
+  inline void MatchMapUsed() {
+    match_map_outdated_ = true;
+    return;
+  }
+
+ private:
+  inline bool HasMatchedAdj(IndexType idx) const {
+    for (const auto &adj_idx : adj_[idx]) {
+      if (is_matched_[adj_idx]) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  inline void AppendParent(std::vector<IndexType> &parent, 
+                           IndexType adj_idx) const {
+    if (!is_matched_[adj_idx] || !has_parent_[adj_idx]) {
+      return;
+    }
+    parent.insert(parent.end(), parent_[adj_idx].begin(), 
+                                parent_[adj_idx].end());
+    return;
+  }
+
+  template <enum EdgeDirection edge_direction>
+  inline bool JoinableCheck(IndexType idx, 
+          TargetVertexHandle target_vertex_handle) {
+    used_edge_.clear();
+    for (const auto &adj_edge : (edge_direction == EdgeDirection::kIn 
+                                ? in_edge_[idx] : out_edge_[idx])) {
+      if (!is_matched_[adj_edge.adj_idx]) {
+        continue;
+      }
+      const TargetVertexHandle &adj_match = match_[adj_edge.adj_idx];
+      bool find_target_flag = false;
+      if constexpr (GraphParameter<TargetGraph>::vertex_level_edge_label_index) {
+        for (auto target_edge_iter = ((edge_direction == EdgeDirection::kIn)
+                                    ? target_vertex_handle->InEdgeBegin(
+                                          adj_edge.label, adj_match)
+                                    : target_vertex_handle->OutEdgeBegin(
+                                          adj_edge.label, adj_match));
+                 !target_edge_iter.IsDone(); 
+                  target_edge_iter++) {
+          if (this->UsedEdge(target_edge_iter->id())) {
+            continue;
+          }
+          find_target_flag = true;
+          used_edge_.emplace_back(target_edge_iter->id());
+          break;
+        }
+      } else {
+        for (auto target_edge_iter = (edge_direction == EdgeDirection::kIn)
+                                    ? target_vertex_handle->InEdgeBegin()
+                                    : target_vertex_handle->OutEdgeBegin();
+                 !target_edge_iter.IsDone(); 
+                  target_edge_iter++) {
+          if (target_edge_iter->label() != adj_edge.label) {
+            continue;
+          }
+          auto opp_vertex_handle = (edge_direction == EdgeDirection::kIn)
+                                 ? target_edge_iter->src_handle()
+                                 : target_edge_iter->dst_handle();
+          if (adj_match != opp_vertex_handle) {
+            continue;
+          }
+          if (this->UsedEdge(target_edge_iter->id())) {
+            continue;
+          }
+          find_target_flag = true;
+          used_edge_.emplace_back(target_edge_iter->id());
+          break;
+        }
+      }
+      if (!find_target_flag) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  inline bool UsedEdge(const TargetEdgeIDType &edge_id) const {
+    // the query is small, linear scan is faster than the tree
+    for (const auto &used_edge_id : used_edge_) {
+      if (used_edge_id == edge_id) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <enum EdgeDirection edge_direction>
+  inline bool UpdateCandidateSetOneDirection(IndexType idx, 
+                          TargetVertexHandle target_vertex_handle) {
+    bool all_not_empty = true;
+    const auto &adj_edges = (edge_direction == EdgeDirection::kIn 
+                           ? in_edge_[idx] : out_edge_[idx]);
+    for (size_t edge_idx = 0; edge_idx < adj_edges.size(); edge_idx++) {
+      const auto &adj_edge = adj_edges[edge_idx];
+      if (is_matched_[adj_edge.adj_idx]) {
+        continue;
+      }
+      // parallel edges with the same label to the same vertex
+      // would only narrow the candidate set once
+      bool processed = false;
+      for (size_t prev_edge_idx = 0; prev_edge_idx < edge_idx; prev_edge_idx++) {
+        if (adj_edges[prev_edge_idx].adj_idx == adj_edge.adj_idx
+         && adj_edges[prev_edge_idx].label   == adj_edge.label) {
+          processed = true;
+          break;
+        }
+      }
+      if (processed) {
+        continue;
+      }
+      size_t adj_count = (edge_direction == EdgeDirection::kIn)
+                       ? _dp_iso::CountInVertex<TargetGraph>(
+                                 target_vertex_handle, adj_edge.label)
+                       : _dp_iso::CountOutVertex<TargetGraph>(
+                                 target_vertex_handle, adj_edge.label);
+      if (adj_count > adj_vertex_limit) {
+        // same as UpdateCandidateSetOneDirection, the vertex
+        // with too many adjacent vertexes is not used as filter
+        continue;
+      }
+      const auto &adj_label = query_handle_[adj_edge.adj_idx]->label();
+      adj_buffer_.clear();
+      if constexpr (GraphParameter<TargetGraph>::vertex_level_edge_label_index) {
+        for (auto vertex_it = ((edge_direction == EdgeDirection::kIn)
+                             ? target_vertex_handle->InVertexBegin(adj_edge.label)
+                             : target_vertex_handle->OutVertexBegin(adj_edge.label));
+                 !vertex_it.IsDone(); 
+                  vertex_it++) {
+          if (vertex_it->label() != adj_label) {
+            continue;
+          }
+          TargetVertexHandle adj_target_handle = vertex_it;
+          adj_buffer_.emplace_back(adj_target_handle);
+        }
+      } else {
+        for (auto edge_it = ((edge_direction == EdgeDirection::kIn)
+                           ? target_vertex_handle->InEdgeBegin()
+                           : target_vertex_handle->OutEdgeBegin());
+                 !edge_it.IsDone(); 
+                  edge_it++) {
+          if (edge_it->label() != adj_edge.label) {
+            continue;
+          }
+          TargetVertexHandle adj_target_handle 
+                     = (edge_direction == EdgeDirection::kIn) 
+                     ? edge_it->src_handle() 
+                     : edge_it->dst_handle();
+          if (adj_target_handle->label() != adj_label) {
+            continue;
+          }
+          adj_buffer_.emplace_back(adj_target_handle);
+        }
+      }
+      std::sort(adj_buffer_.begin(), adj_buffer_.end());
+      adj_buffer_.erase(std::unique(adj_buffer_.begin(), 
+                                    adj_buffer_.end()), 
+                        adj_buffer_.end());
+      CandidateContainer narrowed_candidate;
+      if (!spare_.empty()) {
+        narrowed_candidate = std::move(spare_.back());
+        spare_.pop_back();
+        narrowed_candidate.clear();
+      }
+      auto &adj_candidate = candidate_[adj_edge.adj_idx];
+      std::set_intersection(adj_buffer_.begin(), adj_buffer_.end(),
+                            adj_candidate.begin(), adj_candidate.end(),
+                            std::back_inserter(narrowed_candidate));
+      if (narrowed_candidate.empty()) {
+        all_not_empty = false;
+      }
+      if (narrowed_candidate.size() == adj_candidate.size()) {
+        // not narrowed, nothing to restore
+        spare_.emplace_back(std::move(narrowed_candidate));
+        continue;
+      }
+      trail_.emplace_back(adj_edge.adj_idx, std::move(adj_candidate));
+      adj_candidate = std::move(narrowed_candidate);
+    }
+    return all_not_empty;
+  }
+
+  std::vector<QueryVertexHandle> query_handle_;
+
+  std::vector<std::vector<AdjEdge>> in_edge_,
+                                   out_edge_;
+
+  // distinct adjacent vertexes in both directions
+  std::vector<std::vector<IndexType>> adj_;
+
+  std::vector<TargetVertexHandle> match_;
+
+  std::vector<bool> is_matched_;
+
+  size_t matched_count_;
+
+  TargetMatchedSet target_matched_;
+
+  std::vector<CandidateContainer> candidate_;
+
+  // the replaced candidate sets to restore
+  std::vector<std::pair<IndexType, CandidateContainer>> trail_;
+
+  // released candidate containers to reuse the memory
+  std::vector<CandidateContainer> spare_;
+
+  std::vector<std::vector<IndexType>> parent_;
+
+  std::vector<bool> has_parent_;
+
+  // buffers reused among the search nodes
+  std::vector<TargetVertexHandle> adj_buffer_;
+
+  std::vector<TargetEdgeIDType> used_edge_;
+
+  MatchMap match_map_;
+
+  bool match_map_outdated_;
+};
+
+template <enum MatchSemantics match_semantics, typename QueryGraph,
+          typename TargetGraph, typename MatchCallback, typename PruneCallback>
+bool _DPISO(FlatMatchState<match_semantics, 
+                           QueryGraph, TargetGraph> &match_state,
+            MatchCallback user_callback, PruneCallback prune_callback,
+            time_t begin_time, double query_limit_time = 1200) {
+  using IndexType = typename FlatMatchState<match_semantics, 
+                                            QueryGraph, 
+                                            TargetGraph>::IndexType;
+  if (query_limit_time > 0 &&
+      ((std::time(NULL) - begin_time)) > query_limit_time) {
+    return false;
+  }
+  if constexpr (!std::is_null_pointer_v<PruneCallback>) {
+    bool prune_ret = prune_callback(match_state.match_map());
+    match_state.MatchMapUsed();
+    if (prune_ret) {
+      return true;
+    }
+  }
+
+  if (match_state.matched_count() == match_state.size()) {
+    if constexpr (!std::is_null_pointer_v<MatchCallback>) {
+      bool user_ret = user_callback(match_state.match_map());
+      match_state.MatchMapUsed();
+      return user_ret;
+    } else {
+      // user callback is nullptr,so go on search
+      return true;
+    }
+  }
+  assert(match_state.matched_count() < match_state.size());
+  const IndexType kNextIdx = match_state.NextMatchVertex();
+  assert(kNextIdx != match_state.kNoIndex);
+  assert(!match_state.IsMatched(kNextIdx));
+  // the candidate set of kNextIdx would not be replaced in the
+  // following search since it is matched there
+  const auto &next_candidate = match_state.Candidate(kNextIdx);
+  for (size_t candidate_idx = 0; 
+              candidate_idx < next_candidate.size(); 
+              candidate_idx++) {
+    const auto &next_target_vertex_handle = next_candidate[candidate_idx];
+    if constexpr (!std::is_null_pointer_v<PruneCallback>) {
+      bool prune_ret = prune_callback(match_state.match_map());
+      match_state.MatchMapUsed();
+      if (prune_ret) {
+        return true;
+      }
+    }
+    if (!match_state.IsJoinable(kNextIdx, next_target_vertex_handle)) {
+      continue;
+    }
+    const size_t kTrailSize = match_state.TrailSize();
+    match_state.UpdateState(kNextIdx, next_target_vertex_handle);
+    if (match_state.UpdateCandidateSet(kNextIdx, next_target_vertex_handle)) {
+      if (!_DPISO<match_semantics, QueryGraph, TargetGraph>(
+              match_state, user_callback, prune_callback, 
+              begin_time, query_limit_time)) {
+        return false;
+      }
+    }
+    match_state.RestoreCandidateSet(kTrailSize);
+    match_state.RestoreState(kNextIdx);
+  }
+  return true;
+}
+
+// using Fail Set
+template <enum MatchSemantics match_semantics, typename QueryGraph,
+          typename TargetGraph, typename MatchCallback, typename PruneCallback>
+bool _DPISO(FlatMatchState<match_semantics, 
+                           QueryGraph, TargetGraph> &match_state,
+            std::vector<typename FlatMatchState<match_semantics, 
+                                                QueryGraph, 
+                                                TargetGraph>::IndexType> &fail_set,
+            MatchCallback user_callback, PruneCallback prune_callback,
+            time_t begin_time, double query_limit_time = 1200) {
+  using IndexType = typename FlatMatchState<match_semantics, 
+                                            QueryGraph, 
+                                            TargetGraph>::IndexType;
+  using FailSetType = std::vector<IndexType>;
+
+  if (query_limit_time > 0 &&
+      ((std::time(NULL) - begin_time)) > query_limit_time) {
+    return false;
+  }
+  if constexpr (!std::is_null_pointer_v<PruneCallback>) {
+    bool prune_ret = prune_callback(match_state.match_map());
+    match_state.MatchMapUsed();
+    if (prune_ret) {
+      return true;
+    }
+  }
+  if (match_state.matched_count() == match_state.size()) {
+    // find match ,so fail set is empty
+    fail_set.clear();
+    if constexpr (!std::is_null_pointer_v<MatchCallback>) {
+      bool user_ret = user_callback(match_state.match_map());
+      match_state.MatchMapUsed();
+      return user_ret;
+    } else {
+      // user callback is nullptr,so go on search
+      return true;
+    }
+  }
+  assert(match_state.matched_count() < match_state.size());
+  const IndexType kNextIdx = match_state.NextMatchVertex();
+  assert(kNextIdx != match_state.kNoIndex);
+  assert(!match_state.IsMatched(kNextIdx));
+  // cal this vertex's parent
+  match_state.UpdateParent(kNextIdx);
+  FailSetType this_state_fail_set;
+  bool find_fail_set_flag = false;
+  const auto &next_candidate = match_state.Candidate(kNextIdx);
+  if (next_candidate.empty()) {
+    // C(u) is empty ,so fail set = anc(u)
+    this_state_fail_set = match_state.Parent(kNextIdx);
+  }
+  FailSetType temp_fail_set;
+  for (size_t candidate_idx = 0; 
+              candidate_idx < next_candidate.size(); 
+              candidate_idx++) {
+    const auto &next_target_vertex_handle = next_candidate[candidate_idx];
+    if constexpr (!std::is_null_pointer_v<PruneCallback>) {
+      bool prune_ret = prune_callback(match_state.match_map());
+      match_state.MatchMapUsed();
+      if (prune_ret) {
+        match_state.EraseParent(kNextIdx);
+        return true;
+      }
+    }
+    if (find_fail_set_flag && !this_state_fail_set.empty() &&
+        !std::binary_search(this_state_fail_set.begin(),
+                            this_state_fail_set.end(), kNextIdx)) {
+      // find fail set , u is not in fail set and fail set is not empty!
+      // so not expand
+      match_state.EraseParent(kNextIdx);
+      std::swap(fail_set, this_state_fail_set);
+      return true;
+    }
+    if (!find_fail_set_flag &&
+        match_semantics == MatchSemantics::kIsomorphism &&
+        match_state.IsTargetMatched(next_target_vertex_handle)) {
+      // find u' satisfy that match_state[u']=next_target_vertex_handle
+      // next_state_fail_set = anc[u] union anc[u']
+      const IndexType kConflictIdx 
+                    = match_state.MatchedBy(next_target_vertex_handle);
+      assert(kConflictIdx != match_state.kNoIndex);
+      const auto &next_parent     = match_state.Parent(kNextIdx),
+                 &conflict_parent = match_state.Parent(kConflictIdx);
+      FailSetType next_state_fail_set;
+      std::set_union(next_parent.begin(), next_parent.end(),
+                     conflict_parent.begin(), conflict_parent.end(),
+                     std::back_inserter(next_state_fail_set));
+      // update this_state_fail_set
+      // anc[u] must contain u ,so union fail set
+      temp_fail_set.clear();
+      std::set_union(next_state_fail_set.begin(), next_state_fail_set.end(),
+                     this_state_fail_set.begin(), this_state_fail_set.end(),
+                     std::back_inserter(temp_fail_set));
+      std::swap(this_state_fail_set, temp_fail_set);
+    }
+    if (!match_state.IsJoinable(kNextIdx, next_target_vertex_handle)) {
+      continue;
+    }
+    const size_t kTrailSize = match_state.TrailSize();
+    match_state.UpdateState(kNextIdx, next_target_vertex_handle);
+    match_state.UpdateCandidateSet(kNextIdx, next_target_vertex_handle);
+    FailSetType next_state_fail_set;
+    if (!_DPISO<match_semantics, QueryGraph, TargetGraph>(
+            match_state, next_state_fail_set, user_callback, prune_callback,
+            begin_time, query_limit_time)) {
+      return false;
+    }
+    match_state.RestoreCandidateSet(kTrailSize);
+    match_state.RestoreState(kNextIdx);
+
+    if (next_state_fail_set.empty()) {
+      // if ont child node's fail set is empty
+      // so this state's fail set is empty
+      find_fail_set_flag = true;
+      this_state_fail_set.clear();
+    } else if (!std::binary_search(next_state_fail_set.begin(),
+                                   next_state_fail_set.end(), kNextIdx)) {
+      // if one child node's fail set not contain next_query_vertex_handle
+      // so this state's fail set is next_state_fail_set
+      find_fail_set_flag = true;
+      std::swap(this_state_fail_set, next_state_fail_set);
+    } else if (!find_fail_set_flag) {
+      temp_fail_set.clear();
+      std::set_union(next_state_fail_set.begin(), next_state_fail_set.end(),
+                     this_state_fail_set.begin(), this_state_fail_set.end(),
+                     std::back_inserter(temp_fail_set));
+      std::swap(temp_fail_set, this_state_fail_set);
+    }
+  }
+  // need to restore parent
+  match_state.EraseParent(kNextIdx);
+  std::swap(fail_set, this_state_fail_set);
+  return true;
+}
+
+// run the search on the flat match state from the given candidate set
+// and partial match, which should have already been propagated into the
+// candidate set through UpdateCandidateSet
+template <enum MatchSemantics match_semantics, typename QueryGraph,
+          typename TargetGraph, typename MatchCallback, typename PruneCallback>
+inline bool DPISOUsingFlatState(
+    QueryGraph &query_graph,
+    const std::map<typename VertexHandle<QueryGraph>::type,
+                   std::vector<typename VertexHandle<TargetGraph>::type>>
+        &candidate_set,
+    const std::map<typename VertexHandle<QueryGraph>::type,
+                   typename VertexHandle<TargetGraph>::type> &match_state,
+    MatchCallback user_callback, PruneCallback prune_callback,
+    time_t begin_time, double query_limit_time = 1200) {
+  using FlatMatchStateType = FlatMatchState<match_semantics, 
+                                            QueryGraph, TargetGraph>;
+  FlatMatchStateType flat_match_state(candidate_set, match_state);
+  if (query_graph.CountEdge() < large_query_edge) {
+    return _DPISO<match_semantics, QueryGraph, TargetGraph>(
+        flat_match_state, user_callback, prune_callback, 
+        begin_time, query_limit_time);
+  }
+  // same order as the parent is built from match_state in _DPISO
+  for (const auto &[query_vertex_handle, 
+                   target_vertex_handle] : match_state) {
+    flat_match_state.UpdateParent(
+    flat_match_state.FindIndex(query_vertex_handle));
+  }
+  std::vector<typename FlatMatchStateType::IndexType> fail_set;
+  return _DPISO<match_semantics, QueryGraph, TargetGraph>(
+      flat_match_state, fail_set, user_callback, prune_callback, 
+      begin_time, query_limit_time);
+}
+
 template <class QueryVertexHandle, class TargetVertexHandle>
 bool UpdateCandidateCallbackEmpty(
     std::map<QueryVertexHandle, std::vector<TargetVertexHandle>>
@@ -1542,21 +2388,9 @@ inline int DPISO_Recursive(
 #endif  // NDEBUG
   assert(match_state.count(next_query_ptr) == 0);
   if (!next_query_ptr) {
-    if (query_graph.CountEdge() >= large_query_edge) {
-      std::map<QueryVertexHandle, std::vector<QueryVertexHandle>> parent;
-      for (auto &[query_ptr, target_ptr] : match_state) {
-        _dp_iso::UpdateParent(match_state, query_ptr, parent);
-      }
-      std::vector<QueryVertexHandle> fail_set;
-      _dp_iso::_DPISO<match_semantics, QueryGraph, TargetGraph>(
-          candidate_set, match_state, target_matched, parent, fail_set,
-          par_user_callback, par_prune_callback, std::time(NULL),
-          query_limit_time);
-    } else {
-      _dp_iso::_DPISO<match_semantics, QueryGraph, TargetGraph>(
-          candidate_set, match_state, target_matched, par_user_callback,
-          par_prune_callback, std::time(NULL), query_limit_time);
-    }
+    _dp_iso::DPISOUsingFlatState<match_semantics, QueryGraph, TargetGraph>(
+        query_graph, candidate_set, match_state, par_user_callback,
+        par_prune_callback, std::time(NULL), query_limit_time);
   } else {
     // partition next ptr's candiate
     auto &match_ptr_candidate = candidate_set.find(next_query_ptr)->second;
@@ -1584,27 +2418,12 @@ inline int DPISO_Recursive(
               _dp_iso::UpdateCandidateSet<QueryGraph, TargetGraph>(
                   next_query_ptr, match_target_ptr, temp_candidate_set,
                   temp_match_state, temp_target_matched);
-              if (query_graph.CountEdge() >= large_query_edge) {
-                std::map<QueryVertexHandle, std::vector<QueryVertexHandle>>
-                    parent;
-                for (auto &[query_ptr, target_ptr] : temp_match_state) {
-                  _dp_iso::UpdateParent(temp_match_state, query_ptr, parent);
-                }
-                std::vector<QueryVertexHandle> fail_set;
-                if (!_dp_iso::_DPISO<match_semantics, QueryGraph, TargetGraph>(
-                        temp_candidate_set, temp_match_state,
-                        temp_target_matched, parent, fail_set,
-                        par_user_callback, par_prune_callback, begin_time,
-                        query_limit_time)) {
-                  user_callback_has_return_false = true;
-                }
-              } else {
-                if (!_dp_iso::_DPISO<match_semantics, QueryGraph, TargetGraph>(
-                        temp_candidate_set, temp_match_state,
-                        temp_target_matched, par_user_callback,
-                        par_prune_callback, begin_time, query_limit_time)) {
-                  user_callback_has_return_false = true;
-                }
+              if (!_dp_iso::DPISOUsingFlatState<match_semantics, 
+                                                QueryGraph, TargetGraph>(
+                      query_graph, temp_candidate_set, temp_match_state,
+                      par_user_callback, par_prune_callback, begin_time,
+                      query_limit_time)) {
+                user_callback_has_return_false = true;
               }
             }
           }
@@ -1963,20 +2782,9 @@ inline int DPISO(
         cal_supp_vertex_handle, target_handle, temp_candidate_set, match_state,
         target_matched);
     auto t_end = std::time(NULL);
-    if (query_graph.CountEdge() >= _dp_iso::large_query_edge) {
-      std::map<QueryVertexHandle, std::vector<QueryVertexHandle>> parent;
-      _dp_iso::UpdateParent(match_state, cal_supp_vertex_handle, parent);
-      std::vector<QueryVertexHandle> fail_set;
-
-      _dp_iso::_DPISO<match_semantics, QueryGraph, TargetGraph>(
-          temp_candidate_set, match_state, target_matched, parent, fail_set,
-          user_callback, prune_callback, std::time(NULL),
-          single_query_limit_time);
-    } else {
-      _dp_iso::_DPISO<match_semantics, QueryGraph, TargetGraph>(
-          temp_candidate_set, match_state, target_matched, user_callback,
-          prune_callback, std::time(NULL), single_query_limit_time);
-    }
+    _dp_iso::DPISOUsingFlatState<match_semantics, QueryGraph, TargetGraph>(
+        query_graph, temp_candidate_set, match_state, user_callback,
+        prune_callback, std::time(NULL), single_query_limit_time);
 
     if (max_result == 0) {
       supp.emplace_back(target_handle);
@@ -2220,7 +3028,6 @@ inline int DPISO_UsingPatricalMatchAndMatchSet(QueryGraph &query_graph,
   }
   MatchMap match_state;
   MatchContainer match_result;
-  std::set<TargetVertexHandle> target_matched;
   for (auto vertex_it = query_graph.VertexBegin(); !vertex_it.IsDone();
        vertex_it++) {
     QueryVertexHandle vertex_handle = vertex_it;
@@ -2228,7 +3035,6 @@ inline int DPISO_UsingPatricalMatchAndMatchSet(QueryGraph &query_graph,
       TargetVertexHandle match_vertex_handle =
           partical_match.MapTo(vertex_handle);
       match_state.insert(std::make_pair(vertex_handle, match_vertex_handle));
-      target_matched.insert(match_vertex_handle);
     }
   }
   int max_result = -1;
@@ -2237,23 +3043,9 @@ inline int DPISO_UsingPatricalMatchAndMatchSet(QueryGraph &query_graph,
       _dp_iso::MatchCallbackSaveResult<QueryVertexHandle, TargetVertexHandle,
                                        MatchContainer>,
       std::placeholders::_1, &max_result, &match_result);
-  if (query_graph.CountEdge() < _dp_iso::large_query_edge) {
-    _dp_iso::_DPISO<match_semantics, QueryGraph, TargetGraph>(
-        candidate_set, match_state, target_matched, user_callback, nullptr,
-        std::time(NULL), -1);
-  } else {
-    using FailSetContainer = std::vector<QueryVertexHandle>;
-    using ParentContainer =
-        std::map<QueryVertexHandle, std::vector<QueryVertexHandle>>;
-    ParentContainer parent;
-    FailSetContainer fail_set;
-    for (auto &single_match : match_state) {
-      _dp_iso::UpdateParent(match_state, single_match.first, parent);
-    }
-    _dp_iso::_DPISO<match_semantics, QueryGraph, TargetGraph>(
-        candidate_set, match_state, target_matched, parent, fail_set,
-        user_callback, nullptr, std::time(NULL), -1.0);
-  }
+  _dp_iso::DPISOUsingFlatState<match_semantics, QueryGraph, TargetGraph>(
+      query_graph, candidate_set, match_state, user_callback, nullptr,
+      std::time(NULL), -1.0);
 
   for (auto &single_match : match_result) {
     Match match;
@@ -0,0 +1,694 @@
+#ifndef _GUNDAM_ALGORITHM_DPISO_PARALLEL_H
+#define _GUNDAM_ALGORITHM_DPISO_PARALLEL_H
+#include <omp.h>
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gundam/algorithm/dp_iso.h"
+#include "gundam/type_getter/vertex_handle.h"
+
+namespace GUNDAM {
+
+namespace _dp_iso_parallel {
+
+// the worker checks the time limit once every such number of search nodes
+constexpr size_t kTimeCheckInterval = 1024;
+
+// number of matches held in the local buffer of a worker before
+// it is handed over to the result sink
+constexpr size_t kResultChunkSize = 1024;
+
+// a subtree of the search tree: the prefix is replayed on
+// the root state, then the given candidates are tried for
+// the query vertex idx
+template <typename IndexType, typename TargetVertexHandle>
+struct SearchTask {
+  std::vector<std::pair<IndexType, TargetVertexHandle>> prefix;
+  IndexType idx;
+  std::vector<TargetVertexHandle> candidate;
+};
+
+// shared pool of the subtrees not explored yet, the busy
+// workers split their search tree into it when they find
+// that there are idle workers waiting for tasks
+template <typename TaskType>
+class TaskPool {
+ public:
+  TaskPool() : worker_num_(1),
+               idle_num_(0),
+               task_num_(0),
+                  stop_(false) {
+    return;
+  }
+
+  inline void SetWorkerNum(int worker_num) {
+    worker_num_ = worker_num;
+    return;
+  }
+
+  inline void Put(TaskType &&task) {
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      tasks_.emplace_back(std::move(task));
+      task_num_.fetch_add(1, std::memory_order_relaxed);
+    }
+    cv_.notify_one();
+    return;
+  }
+
+  // blocks until there is a task, returns false when the search
+  // is stopped or all workers are idle with no task left
+  inline bool Get(TaskType &task) {
+    std::unique_lock<std::mutex> lock(lock_);
+    idle_num_.fetch_add(1, std::memory_order_relaxed);
+    while (tasks_.empty() && !stop_.load(std::memory_order_relaxed)) {
+      if (idle_num_.load(std::memory_order_relaxed) == worker_num_) {
+        // no worker is busy, no more task can be put
+        stop_.store(true, std::memory_order_relaxed);
+        cv_.notify_all();
+        break;
+      }
+      cv_.wait(lock);
+    }
+    if (stop_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    task = std::move(tasks_.front());
+    tasks_.pop_front();
+    task_num_.fetch_sub(1, std::memory_order_relaxed);
+    idle_num_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // whether there are more idle workers than tasks to hand
+  // out, read without the lock since it is only a hint
+  inline bool Hungry() const {
+    return idle_num_.load(std::memory_order_relaxed)
+           > task_num_.load(std::memory_order_relaxed);
+  }
+
+  inline void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      stop_.store(true, std::memory_order_relaxed);
+    }
+    cv_.notify_all();
+    return;
+  }
+
+  inline bool stopped() const {
+    return stop_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::mutex lock_;
+
+  std::condition_variable cv_;
+
+  std::deque<TaskType> tasks_;
+
+  int worker_num_;
+
+  std::atomic<int> idle_num_;
+
+  std::atomic<int> task_num_;
+
+  std::atomic<bool> stop_;
+};
+
+// collects the matches found by the workers without holding
+// a lock: each worker appends the target vertexes of a match
+// to its own buffer, full buffers are pushed onto a lock-free
+// stack, and the worker that first finds the sink not being
+// drained calls the user callback on all matches in it. the
+// user callback is therefore never called concurrently while
+// the other workers go on searching instead of waiting for it.
+template <typename QueryVertexHandle,
+          typename TargetVertexHandle,
+          typename MatchCallback>
+class ResultSink {
+ private:
+  struct Chunk {
+    std::vector<TargetVertexHandle> row;
+    Chunk *next;
+  };
+
+ public:
+  using MatchMap = std::map<QueryVertexHandle, TargetVertexHandle>;
+
+  ResultSink(std::vector<QueryVertexHandle> &&query_handle,
+             MatchCallback &user_callback)
+                : query_handle_(std::move(query_handle)),
+                  user_callback_(user_callback),
+                  head_(nullptr),
+                  stop_(false),
+                  result_count_(0) {
+    draining_.clear();
+    return;
+  }
+
+  ~ResultSink() {
+    Chunk *chunk = head_.load(std::memory_order_acquire);
+    while (chunk) {
+      Chunk *next = chunk->next;
+      delete chunk;
+      chunk = next;
+    }
+    return;
+  }
+
+  inline void SetWorkerNum(int worker_num) {
+    local_.resize(worker_num);
+    return;
+  }
+
+  // the target vertexes are given in the dense order of
+  // the query vertexes, same as query_handle_
+  template <typename StateType>
+  inline void Push(int worker_id, const StateType &match_state) {
+    auto &local = local_[worker_id];
+    for (typename StateType::IndexType idx = 0;
+                                       idx < match_state.size();
+                                       idx++) {
+      local.emplace_back(match_state.MatchTo(idx));
+    }
+    if (local.size() < kResultChunkSize * query_handle_.size()) {
+      return;
+    }
+    this->Publish(worker_id);
+    this->TryDrain();
+    return;
+  }
+
+  inline void Flush(int worker_id) {
+    if (local_[worker_id].empty()) {
+      return;
+    }
+    this->Publish(worker_id);
+    return;
+  }
+
+  inline void TryDrain() {
+    if (draining_.test_and_set(std::memory_order_acquire)) {
+      // another worker is calling the user callback
+      return;
+    }
+    this->Drain();
+    draining_.clear(std::memory_order_release);
+    return;
+  }
+
+  // should not be called concurrently
+  inline void Drain() {
+    Chunk *chunk = head_.exchange(nullptr, std::memory_order_acq_rel);
+    // the stack holds the chunks in reverse order of publishing
+    Chunk *reversed = nullptr;
+    while (chunk) {
+      Chunk *next = chunk->next;
+      chunk->next = reversed;
+      reversed = chunk;
+      chunk = next;
+    }
+    while (reversed) {
+      Chunk *next = reversed->next;
+      this->Deliver(reversed->row);
+      delete reversed;
+      reversed = next;
+    }
+    return;
+  }
+
+  // the user callback has returned false
+  inline bool stopped() const {
+    return stop_.load(std::memory_order_relaxed);
+  }
+
+  inline size_t result_count() const { return result_count_; }
+
+ private:
+  inline void Publish(int worker_id) {
+    Chunk *chunk = new Chunk;
+    chunk->row.swap(local_[worker_id]);
+    local_[worker_id].reserve(kResultChunkSize * query_handle_.size());
+    chunk->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(chunk->next, chunk,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+    return;
+  }
+
+  inline void Deliver(const std::vector<TargetVertexHandle> &row) {
+    const size_t kWidth = query_handle_.size();
+    for (size_t row_begin = 0; row_begin < row.size(); row_begin += kWidth) {
+      if (this->stopped()) {
+        return;
+      }
+      result_count_++;
+      if constexpr (std::is_null_pointer_v<MatchCallback>) {
+        continue;
+      } else {
+        if (match_map_.size() != kWidth) {
+          // first match or the map has been modified by the user callback
+          match_map_.clear();
+          for (size_t idx = 0; idx < kWidth; idx++) {
+            match_map_.emplace_hint(match_map_.end(), query_handle_[idx],
+                                                      row[row_begin + idx]);
+          }
+        } else {
+          // query_handle_ is in the same order as the map
+          size_t idx = 0;
+          for (auto &[query_handle, target_handle] : match_map_) {
+            target_handle = row[row_begin + idx];
+            idx++;
+          }
+        }
+        if (!user_callback_(match_map_)) {
+          stop_.store(true, std::memory_order_relaxed);
+        }
+      }
+    }
+    return;
+  }
+
+  const std::vector<QueryVertexHandle> query_handle_;
+
+  MatchCallback &user_callback_;
+
+  std::vector<std::vector<TargetVertexHandle>> local_;
+
+  std::atomic<Chunk*> head_;
+
+  std::atomic_flag draining_;
+
+  std::atomic<bool> stop_;
+
+  size_t result_count_;
+
+  MatchMap match_map_;
+};
+
+// explores the tasks taken from the pool on its own flat match
+// state, the search is iterative so that the untried candidates
+// of any level can be split off when there are idle workers
+template <enum MatchSemantics match_semantics,
+          typename QueryGraph,
+          typename TargetGraph,
+          typename SinkType,
+          typename PruneCallback>
+class Searcher {
+ public:
+  using StateType = _dp_iso::FlatMatchState<match_semantics,
+                                            QueryGraph,
+                                            TargetGraph>;
+
+  using  QueryVertexHandle = typename VertexHandle< QueryGraph>::type;
+  using TargetVertexHandle = typename VertexHandle<TargetGraph>::type;
+
+  using IndexType = typename StateType::IndexType;
+
+  using TaskType = SearchTask<IndexType, TargetVertexHandle>;
+
+ private:
+  struct Frame {
+    IndexType idx;
+    const std::vector<TargetVertexHandle> *candidate;
+    size_t pos;
+    size_t end;
+    size_t trail_size;
+    bool matched;
+  };
+
+ public:
+  Searcher(const typename StateType::CandidateSetContainer &candidate_set,
+           const typename StateType::MatchMap &match_state,
+           TaskPool<TaskType> &pool, SinkType &sink,
+           PruneCallback prune_callback, int worker_id,
+           time_t begin_time, double query_limit_time)
+      : match_state_(candidate_set, match_state),
+        pool_(pool),
+        sink_(sink),
+        prune_callback_(prune_callback),
+        worker_id_(worker_id),
+        begin_time_(begin_time),
+        query_limit_time_(query_limit_time),
+        node_count_(0) {
+    return;
+  }
+
+  // returns false if the time limit is exceeded
+  inline bool Run(TaskType &task) {
+    const size_t kRootTrailSize = match_state_.TrailSize();
+    for (const auto &[idx, target_vertex_handle] : task.prefix) {
+      // the prefix has been checked by the worker that splits it
+      match_state_.UpdateState(idx, target_vertex_handle);
+      bool not_empty = match_state_.UpdateCandidateSet(idx,
+                                         target_vertex_handle);
+      assert(not_empty);
+    }
+    std::swap(prefix_, task.prefix);
+    frames_.clear();
+    frames_.push_back(Frame{task.idx, &task.candidate, 0,
+                            task.candidate.size(), 0, false});
+    const bool kRet = this->Search();
+    // restore the root state for the next task
+    frames_.clear();
+    match_state_.RestoreCandidateSet(kRootTrailSize);
+    for (auto it = prefix_.rbegin(); it != prefix_.rend(); it++) {
+      match_state_.RestoreState(it->first);
+    }
+    return kRet;
+  }
+
+ private:
+  inline bool Prune() {
+    if constexpr (std::is_null_pointer_v<PruneCallback>) {
+      return false;
+    } else {
+      bool prune_ret = prune_callback_(match_state_.match_map());
+      match_state_.MatchMapUsed();
+      return prune_ret;
+    }
+  }
+
+  inline bool OutOfTime() {
+    node_count_++;
+    if (node_count_ % kTimeCheckInterval != 0) {
+      return false;
+    }
+    return query_limit_time_ > 0
+        && (std::time(NULL) - begin_time_) > query_limit_time_;
+  }
+
+  // same order of search as _dp_iso::_DPISO on the flat match state
+  inline bool Search() {
+    while (!frames_.empty()) {
+      if (pool_.stopped() || sink_.stopped()) {
+        this->Unwind();
+        return true;
+      }
+      if (frames_.back().matched) {
+        Frame &frame = frames_.back();
+        match_state_.RestoreCandidateSet(frame.trail_size);
+        match_state_.RestoreState(frame.idx);
+        frame.matched = false;
+      }
+      if (pool_.Hungry()) {
+        this->Split();
+      }
+      Frame &frame = frames_.back();
+      if (frame.pos == frame.end) {
+        frames_.pop_back();
+        continue;
+      }
+      const TargetVertexHandle &target_vertex_handle
+                            = (*frame.candidate)[frame.pos];
+      frame.pos++;
+      if (this->Prune()) {
+        frame.pos = frame.end;
+        continue;
+      }
+      if (!match_state_.IsJoinable(frame.idx, target_vertex_handle)) {
+        continue;
+      }
+      frame.trail_size = match_state_.TrailSize();
+      match_state_.UpdateState(frame.idx, target_vertex_handle);
+      frame.matched = true;
+      if (!match_state_.UpdateCandidateSet(frame.idx,
+                                           target_vertex_handle)) {
+        continue;
+      }
+      // enter the child node
+      if (this->OutOfTime()) {
+        this->Unwind();
+        return false;
+      }
+      if (this->Prune()) {
+        continue;
+      }
+      if (match_state_.matched_count() == match_state_.size()) {
+        sink_.Push(worker_id_, match_state_);
+        continue;
+      }
+      const IndexType kNextIdx = match_state_.NextMatchVertex();
+      assert(kNextIdx != StateType::kNoIndex);
+      const auto &next_candidate = match_state_.Candidate(kNextIdx);
+      frames_.push_back(Frame{kNextIdx, &next_candidate, 0,
+                              next_candidate.size(), 0, false});
+    }
+    return true;
+  }
+
+  inline void Unwind() {
+    while (!frames_.empty()) {
+      Frame &frame = frames_.back();
+      if (frame.matched) {
+        match_state_.RestoreCandidateSet(frame.trail_size);
+        match_state_.RestoreState(frame.idx);
+      }
+      frames_.pop_back();
+    }
+    return;
+  }
+
+  // hands the upper half of the untried candidates on the
+  // shallowest level over to the pool, the subtrees there
+  // are expected to be the largest ones
+  inline void Split() {
+    for (size_t depth = 0; depth < frames_.size(); depth++) {
+      Frame &frame = frames_[depth];
+      const size_t kRemain = frame.end - frame.pos;
+      const bool kIsLast = (depth + 1 == frames_.size());
+      if (kRemain == 0 || (kIsLast && kRemain < 2)) {
+        continue;
+      }
+      const size_t kMid = frame.pos + kRemain / 2;
+      TaskType task;
+      task.prefix.reserve(prefix_.size() + depth);
+      task.prefix = prefix_;
+      for (size_t matched_depth = 0; matched_depth < depth; matched_depth++) {
+        const Frame &matched_frame = frames_[matched_depth];
+        assert(matched_frame.matched);
+        task.prefix.emplace_back(matched_frame.idx,
+              (*matched_frame.candidate)[matched_frame.pos - 1]);
+      }
+      task.idx = frame.idx;
+      task.candidate.assign(frame.candidate->begin() + kMid,
+                            frame.candidate->begin() + frame.end);
+      frame.end = kMid;
+      pool_.Put(std::move(task));
+      return;
+    }
+    return;
+  }
+
+  StateType match_state_;
+
+  TaskPool<TaskType> &pool_;
+
+  SinkType &sink_;
+
+  PruneCallback prune_callback_;
+
+  const int worker_id_;
+
+  const time_t begin_time_;
+
+  const double query_limit_time_;
+
+  size_t node_count_;
+
+  // the matches the current task starts from
+  std::vector<std::pair<IndexType, TargetVertexHandle>> prefix_;
+
+  std::vector<Frame> frames_;
+};
+
+}  // namespace _dp_iso_parallel
+
+// parallel DPISO with work stealing, each worker holds its
+// own flat match state and the busy workers split off the
+// untried candidates of the shallowest level of their search
+// tree when others go idle, so that a skewed candidate set
+// does not leave the most of the threads waiting.
+//
+// the user callback is called serially through a lock-free
+// result sink, possibly after the match is found and not from
+// the thread that found it; the prune callback is called by
+// all workers and is serialized with a lock as in
+// DPISO_Recursive. the fail set is not used in this mode.
+template <enum MatchSemantics match_semantics = MatchSemantics::kIsomorphism,
+          typename QueryGraph, typename TargetGraph,
+          class MatchCallback, class PruneCallback>
+inline int DPISO_Parallel(
+    QueryGraph &query_graph, TargetGraph &target_graph,
+    std::map<typename VertexHandle<QueryGraph>::type,
+             std::vector<typename VertexHandle<TargetGraph>::type>>
+        &candidate_set,
+    std::map<typename VertexHandle<QueryGraph>::type,
+             typename VertexHandle<TargetGraph>::type> &match_state,
+    MatchCallback user_callback, PruneCallback prune_callback,
+    int thread_num, double query_limit_time = 1200.0) {
+  using  QueryVertexHandle = typename VertexHandle< QueryGraph>::type;
+  using TargetVertexHandle = typename VertexHandle<TargetGraph>::type;
+
+  using StateType = _dp_iso::FlatMatchState<match_semantics,
+                                            QueryGraph,
+                                            TargetGraph>;
+  using SinkType = _dp_iso_parallel::ResultSink<QueryVertexHandle,
+                                                TargetVertexHandle,
+                                                MatchCallback>;
+  using TaskType = _dp_iso_parallel::SearchTask<
+                                typename StateType::IndexType,
+                                TargetVertexHandle>;
+
+  if (!_dp_iso::CheckMatchIsLegal<match_semantics, QueryGraph, TargetGraph>(
+          match_state)) {
+    // partial match is not legal.
+    return 0;
+  }
+  std::set<TargetVertexHandle> target_matched;
+  for (auto &[query_ptr, target_ptr] : match_state) {
+    target_matched.insert(target_ptr);
+  }
+  for (auto &[query_ptr, target_ptr] : match_state) {
+    _dp_iso::UpdateCandidateSet<QueryGraph, TargetGraph>(
+        query_ptr, target_ptr, candidate_set, match_state, target_matched);
+  }
+
+  omp_lock_t prune_callback_lock;
+  omp_init_lock(&prune_callback_lock);
+  auto par_prune_callback = [&prune_callback_lock,
+                             &prune_callback](auto &match_state) {
+    bool ret_val = false;
+    if constexpr (!std::is_null_pointer_v<PruneCallback>) {
+      omp_set_lock(&prune_callback_lock);
+      ret_val = prune_callback(match_state);
+      omp_unset_lock(&prune_callback_lock);
+    }
+    return ret_val;
+  };
+  // the match map is not built for the prune callback at
+  // each search node if there is none
+  auto searcher_prune_callback = [&par_prune_callback]() {
+    if constexpr (std::is_null_pointer_v<PruneCallback>) {
+      return nullptr;
+    } else {
+      return par_prune_callback;
+    }
+  }();
+  using SearcherPruneCallback = decltype(searcher_prune_callback);
+
+  StateType root_state(candidate_set, match_state);
+  std::vector<QueryVertexHandle> query_handle;
+  query_handle.reserve(root_state.size());
+  for (typename StateType::IndexType idx = 0; idx < root_state.size(); idx++) {
+    query_handle.emplace_back(root_state.QueryHandle(idx));
+  }
+  SinkType sink(std::move(query_handle), user_callback);
+
+  if (par_prune_callback(root_state.match_map())) {
+    omp_destroy_lock(&prune_callback_lock);
+    return 0;
+  }
+  root_state.MatchMapUsed();
+  if (root_state.matched_count() == root_state.size()) {
+    omp_destroy_lock(&prune_callback_lock);
+    sink.SetWorkerNum(1);
+    sink.Push(0, root_state);
+    sink.Flush(0);
+    sink.Drain();
+    return static_cast<int>(sink.result_count());
+  }
+
+  const time_t kBeginTime = std::time(NULL);
+
+  _dp_iso_parallel::TaskPool<TaskType> pool;
+  TaskType root_task;
+  root_task.idx = root_state.NextMatchVertex();
+  root_task.candidate = root_state.Candidate(root_task.idx);
+  pool.Put(std::move(root_task));
+
+  if (thread_num <= 0) {
+    thread_num = omp_get_max_threads();
+  }
+#pragma omp parallel num_threads(thread_num)
+  {
+#pragma omp single
+    {
+      pool.SetWorkerNum(omp_get_num_threads());
+      sink.SetWorkerNum(omp_get_num_threads());
+    }
+    const int kWorkerId = omp_get_thread_num();
+    _dp_iso_parallel::Searcher<match_semantics, QueryGraph, TargetGraph,
+                               SinkType, SearcherPruneCallback>
+        searcher(candidate_set, match_state, pool, sink,
+                 searcher_prune_callback,
+                 kWorkerId, kBeginTime, query_limit_time);
+    TaskType task;
+    while (pool.Get(task)) {
+      if (!searcher.Run(task)) {
+        // out of time
+        pool.Stop();
+      }
+    }
+    sink.Flush(kWorkerId);
+  }
+  sink.Drain();
+  omp_destroy_lock(&prune_callback_lock);
+  return static_cast<int>(sink.result_count());
+}
+
+template <enum MatchSemantics match_semantics = MatchSemantics::kIsomorphism,
+          typename QueryGraph, typename TargetGraph, class MatchCallback,
+          class PruneCallback, class UpdateCandidateCallback>
+inline int DPISO_Parallel(QueryGraph &query_graph, TargetGraph &target_graph,
+                          MatchCallback user_callback,
+                          PruneCallback prune_callback,
+                          UpdateCandidateCallback update_candidate_callback,
+                          int thread_num, double query_limit_time = 1200) {
+  using  QueryVertexHandle = typename VertexHandle< QueryGraph>::type;
+  using TargetVertexHandle = typename VertexHandle<TargetGraph>::type;
+
+  std::map<QueryVertexHandle, std::vector<TargetVertexHandle>> candidate_set;
+  if (!_dp_iso::InitCandidateSet<match_semantics>(query_graph, target_graph,
+                                                  candidate_set)) {
+    return 0;
+  }
+  if (!_dp_iso::RefineCandidateSet(query_graph, target_graph, candidate_set)) {
+    return 0;
+  }
+  if constexpr (!std::is_null_pointer_v<UpdateCandidateCallback>) {
+    if (!update_candidate_callback(candidate_set)) {
+      return 0;
+    }
+  }
+  std::map<QueryVertexHandle, TargetVertexHandle> match_state;
+  return DPISO_Parallel<match_semantics>(
+      query_graph, target_graph, candidate_set, match_state, user_callback,
+      prune_callback, thread_num, query_limit_time);
+}
+
+template <enum MatchSemantics match_semantics = MatchSemantics::kIsomorphism,
+          typename QueryGraph, typename TargetGraph, class MatchCallback>
+inline int DPISO_Parallel(QueryGraph &query_graph, TargetGraph &target_graph,
+                          MatchCallback user_callback, int thread_num,
+                          double query_limit_time = 1200) {
+  return DPISO_Parallel<match_semantics>(query_graph, target_graph,
+                                         user_callback, nullptr, nullptr,
+                                         thread_num, query_limit_time);
+}
+
+}  // namespace GUNDAM
+
+#endif  // _GUNDAM_ALGORITHM_DPISO_PARALLEL_H
@@ -1,8 +1,13 @@
 #ifndef _GUNDAM_COMPONENT_ATTRIBUTE_H
 #define _GUNDAM_COMPONENT_ATTRIBUTE_H
 
+#include <cstdint>
+#include <map>
 #include <sstream>
 #include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #include "gundam/component/container.h"
@@ -14,7 +19,8 @@ namespace GUNDAM {
 enum class AttributeType : uint8_t {
   kSeparated       = 0, /// each vertex/edge has its own vertex container 
   kGrouped         = 1, /// a group of vertexes/edges shares the same key
-  kGroupedSameType = 2  /// a group of vertexes/edges shares the same key and value type
+  kGroupedSameType = 2, /// a group of vertexes/edges shares the same key and value type
+  kColumnar        = 3  /// a group of vertexes/edges shares typed columns of each key
 };
 
 template<enum AttributeType attr_type,
@@ -1725,6 +1731,973 @@ class Attribute_<AttributeType::kGrouped,
   AttributeContainerGroupType* attribute_container_group_ptr_;
 };
 
+namespace _attribute {
+
+/// index of the lowest set bit in a non-zero word
+inline unsigned LowestBit(uint64_t word) {
+  assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(word);
+#else
+  unsigned bit = 0;
+  while (!((word >> bit) & 1)) {
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+/// dense values of a column indexed by slot, the value of a slot
+/// without value is default constructed
+template <typename ConcreteDataType>
+class ColumnValues {
+ private:
+  /// avoids std::vector<bool>, value() returns a reference
+  struct Cell {
+    ConcreteDataType value_;
+  };
+
+ public:
+  inline const ConcreteDataType& const_value(size_t slot) const {
+    assert(slot < this->cells_.size());
+    return this->cells_[slot].value_;
+  }
+
+  inline ConcreteDataType& value(size_t slot) {
+    assert(slot < this->cells_.size());
+    return this->cells_[slot].value_;
+  }
+
+  /// the slot should not have value
+  inline void Emplace(size_t slot, const ConcreteDataType& value) {
+    if (slot >= this->cells_.size()) {
+      this->cells_.resize(slot + 1);
+    }
+    this->cells_[slot].value_ = value;
+    return;
+  }
+
+  /// the slot should have value
+  inline void Erase(size_t slot) {
+    assert(slot < this->cells_.size());
+    this->cells_[slot].value_ = ConcreteDataType();
+    return;
+  }
+
+  /// set the bit of each slot whose value satisfies the predicate
+  template <typename Predicate>
+  inline void Evaluate(Predicate predicate,
+                       std::vector<uint64_t>& bitmap) const {
+    bitmap.assign((this->cells_.size() + 63) / 64, 0);
+    for (size_t slot = 0; slot < this->cells_.size(); slot++) {
+      bitmap[slot >> 6] |= static_cast<uint64_t>(
+          static_cast<bool>(predicate(this->cells_[slot].value_)))
+                        << (slot & 63);
+    }
+    return;
+  }
+
+ private:
+  std::vector<Cell> cells_;
+};
+
+/// dictionary encoded strings, the slots holding the same string
+/// share one entry in the dictionary, the entry is made private to
+/// the slot when a mutable reference to it is taken
+template <>
+class ColumnValues<std::string> {
+ private:
+  using CodeType = uint32_t;
+
+  inline CodeType NewCode(const std::string& value) {
+    if (!this->free_codes_.empty()) {
+      const CodeType kCode = this->free_codes_.back();
+      this->free_codes_.pop_back();
+      this->dict_[kCode] = value;
+      this->ref_count_[kCode] = 1;
+      return kCode;
+    }
+    this->dict_.emplace_back(value);
+    this->ref_count_.emplace_back(1);
+    return this->dict_.size() - 1;
+  }
+
+  /// whether the entry can be shared by other slots
+  inline bool IsShared(CodeType code) const {
+    auto it = this->code_of_.find(this->dict_[code]);
+    return it != this->code_of_.end() && it->second == code;
+  }
+
+  inline void Release(CodeType code) {
+    assert(this->ref_count_[code] > 0);
+    if (--this->ref_count_[code] > 0) {
+      return;
+    }
+    if (this->IsShared(code)) {
+      this->code_of_.erase(this->dict_[code]);
+    }
+    this->dict_[code].clear();
+    this->free_codes_.emplace_back(code);
+    return;
+  }
+
+ public:
+  inline const std::string& const_value(size_t slot) const {
+    assert(slot < this->codes_.size());
+    return this->dict_[this->codes_[slot]];
+  }
+
+  inline std::string& value(size_t slot) {
+    assert(slot < this->codes_.size());
+    CodeType& code = this->codes_[slot];
+    if (this->ref_count_[code] > 1) {
+      // shared with other slots, copy it
+      this->ref_count_[code]--;
+      code = this->NewCode(std::string(this->dict_[code]));
+      return this->dict_[code];
+    }
+    if (this->IsShared(code)) {
+      // the string can be modified through the reference,
+      // does not share it anymore
+      this->code_of_.erase(this->dict_[code]);
+    }
+    return this->dict_[code];
+  }
+
+  inline void Emplace(size_t slot, const std::string& value) {
+    if (slot >= this->codes_.size()) {
+      this->codes_.resize(slot + 1, 0);
+    }
+    auto it = this->code_of_.find(value);
+    if (it != this->code_of_.end()) {
+      this->ref_count_[it->second]++;
+      this->codes_[slot] = it->second;
+      return;
+    }
+    const CodeType kCode = this->NewCode(value);
+    this->code_of_.emplace(value, kCode);
+    this->codes_[slot] = kCode;
+    return;
+  }
+
+  inline void Erase(size_t slot) {
+    assert(slot < this->codes_.size());
+    this->Release(this->codes_[slot]);
+    this->codes_[slot] = 0;
+    return;
+  }
+
+  /// the predicate is evaluated once for each entry in the dictionary
+  template <typename Predicate>
+  inline void Evaluate(Predicate predicate,
+                       std::vector<uint64_t>& bitmap) const {
+    std::vector<uint8_t> code_satisfied(this->dict_.size());
+    for (size_t code = 0; code < this->dict_.size(); code++) {
+      code_satisfied[code] = static_cast<bool>(predicate(this->dict_[code]));
+    }
+    bitmap.assign((this->codes_.size() + 63) / 64, 0);
+    if (this->dict_.empty()) {
+      return;
+    }
+    for (size_t slot = 0; slot < this->codes_.size(); slot++) {
+      bitmap[slot >> 6] |= static_cast<uint64_t>(
+          code_satisfied[this->codes_[slot]]) << (slot & 63);
+    }
+    return;
+  }
+
+  inline size_t DictSize() const {
+    return this->dict_.size() - this->free_codes_.size();
+  }
+
+ private:
+  std::vector<CodeType> codes_;
+
+  std::vector<std::string> dict_;
+
+  std::vector<size_t> ref_count_;
+
+  std::vector<CodeType> free_codes_;
+
+  /// entries that can be shared
+  std::unordered_map<std::string, CodeType> code_of_;
+};
+
+}  // namespace _attribute
+
+/// columnar attribute container
+/// the attributes of the containers in a same group are held in typed
+/// columns, one for each attribute key and value type. Each container
+/// holds a slot in the group, a column holds the values of all slots
+/// in a dense array together with a bitmap marking the slots with value
+template<bool           attribute_is_const_,
+         typename             GroupKeyType_,
+         typename         AttributeKeyType_,
+         enum ContainerType container_type_,
+         enum      SortType      sort_type_>
+class Attribute_<AttributeType::kColumnar,
+                     attribute_is_const_,
+                           GroupKeyType_,
+                       AttributeKeyType_,
+                         container_type_,
+                              sort_type_>{
+ public:
+  using SlotType = size_t;
+
+  class AbstractColumn {
+   public:
+    AbstractColumn(const AttributeKeyType_& key,
+                   const std::type_index& type)
+                                  : key_(key),
+                                    type_(type),
+                               value_count_(0) {
+      return;
+    }
+
+    virtual ~AbstractColumn() {
+      return;
+    }
+
+    inline const AttributeKeyType_& key() const {
+      return this->key_;
+    }
+
+    inline const std::type_index& type() const {
+      return this->type_;
+    }
+
+    inline bool HasValue(const SlotType& slot) const {
+      const size_t kWordIdx = slot >> 6;
+      return kWordIdx < this->has_value_.size()
+         && ((this->has_value_[kWordIdx] >> (slot & 63)) & 1);
+    }
+
+    /// number of slots with value
+    inline size_t Count() const {
+      return this->value_count_;
+    }
+
+    /// bit (slot & 63) of word (slot >> 6) marks whether the
+    /// slot has value
+    inline const std::vector<uint64_t>& has_value_bitmap() const {
+      return this->has_value_;
+    }
+
+    virtual enum BasicDataType value_type() const = 0;
+
+    virtual std::string value_str(const SlotType& slot) const = 0;
+
+    /// return false if the slot does not have value
+    virtual bool EraseValue(const SlotType& slot) = 0;
+
+   protected:
+    inline void MarkHasValue(const SlotType& slot) {
+      assert(!this->HasValue(slot));
+      const size_t kWordIdx = slot >> 6;
+      if (kWordIdx >= this->has_value_.size()) {
+        this->has_value_.resize(kWordIdx + 1, 0);
+      }
+      this->has_value_[kWordIdx] |= (uint64_t)1 << (slot & 63);
+      this->value_count_++;
+      return;
+    }
+
+    inline void MarkNoValue(const SlotType& slot) {
+      assert(this->HasValue(slot));
+      this->has_value_[slot >> 6] &= ~((uint64_t)1 << (slot & 63));
+      this->value_count_--;
+      return;
+    }
+
+   private:
+    AttributeKeyType_ key_;
+
+    std::type_index type_;
+
+    std::vector<uint64_t> has_value_;
+
+    size_t value_count_;
+  };
+
+  template <typename ConcreteDataType>
+  class ConcreteColumn : public AbstractColumn {
+   public:
+    ConcreteColumn(const AttributeKeyType_& key)
+       : AbstractColumn(key, std::type_index(typeid(ConcreteDataType))) {
+      return;
+    }
+
+    ~ConcreteColumn() override {
+      return;
+    }
+
+    inline enum BasicDataType value_type() const override {
+      return TypeToEnum<ConcreteDataType>();
+    }
+
+    inline std::string value_str(const SlotType& slot) const override {
+      assert(this->HasValue(slot));
+      if constexpr (TypeToEnum<ConcreteDataType>()
+                  != BasicDataType::kTypeUnknown) {
+        std::stringstream ss;
+        ss << this->values_.const_value(slot);
+        return ss.str();
+      }
+      return "unknown value type";
+    }
+
+    inline const ConcreteDataType& const_value(const SlotType& slot) const {
+      assert(this->HasValue(slot));
+      return this->values_.const_value(slot);
+    }
+
+    inline ConcreteDataType& value(const SlotType& slot) {
+      assert(this->HasValue(slot));
+      return this->values_.value(slot);
+    }
+
+    /// return false if the slot already has value
+    inline bool AddValue(const SlotType& slot,
+                         const ConcreteDataType& value) {
+      if (this->HasValue(slot)) {
+        return false;
+      }
+      this->values_.Emplace(slot, value);
+      this->MarkHasValue(slot);
+      return true;
+    }
+
+    /// return false if the slot does not have value
+    inline bool SetValue(const SlotType& slot,
+                         const ConcreteDataType& value) {
+      if (!this->HasValue(slot)) {
+        return false;
+      }
+      this->values_.Erase(slot);
+      this->values_.Emplace(slot, value);
+      return true;
+    }
+
+    inline bool EraseValue(const SlotType& slot) override {
+      if (!this->HasValue(slot)) {
+        return false;
+      }
+      this->values_.Erase(slot);
+      this->MarkNoValue(slot);
+      return true;
+    }
+
+    /// calls callback(slot, value) for each slot with value in
+    /// ascending order of the slot
+    template <typename Callback>
+    inline void ForEach(Callback callback) const {
+      const auto& bitmap = this->has_value_bitmap();
+      for (size_t word_idx = 0; word_idx < bitmap.size(); word_idx++) {
+        uint64_t word = bitmap[word_idx];
+        while (word != 0) {
+          const SlotType kSlot = (word_idx << 6)
+                               + _attribute::LowestBit(word);
+          callback(kSlot, this->values_.const_value(kSlot));
+          word &= word - 1;
+        }
+      }
+      return;
+    }
+
+    /// the bitmap of the slots that have value and the value satisfies
+    /// the predicate, in the same layout as has_value_bitmap()
+    template <typename Predicate>
+    inline std::vector<uint64_t> Select(Predicate predicate) const {
+      std::vector<uint64_t> bitmap;
+      this->values_.Evaluate(predicate, bitmap);
+      const auto& has_value = this->has_value_bitmap();
+      bitmap.resize(has_value.size(), 0);
+      for (size_t word_idx = 0; word_idx < bitmap.size(); word_idx++) {
+        bitmap[word_idx] &= has_value[word_idx];
+      }
+      return bitmap;
+    }
+
+   private:
+    _attribute::ColumnValues<ConcreteDataType> values_;
+  };
+
+  template <typename ConcreteDataType>
+  using ColumnPtr = ConcreteColumn<ConcreteDataType>*;
+
+  template <typename ConcreteDataType>
+  using ColumnConstPtr = const ConcreteColumn<ConcreteDataType>*;
+
+ private:
+  /// all columns for one key, one for each value type,
+  /// mostly only one
+  using ColumnList = std::vector<AbstractColumn*>;
+
+  using ColumnListContainerType = std::map<AttributeKeyType_, ColumnList>;
+
+  class ColumnGroup_ {
+   public:
+    ColumnGroup_() : top_slot_(0), slot_count_(0) {
+      return;
+    }
+
+    ~ColumnGroup_() {
+      for (auto& [key, column_list] : this->columns_) {
+        for (auto& column_ptr : column_list) {
+          delete column_ptr;
+        }
+      }
+      return;
+    }
+
+    inline SlotType AllocSlot() {
+      this->slot_count_++;
+      if (this->free_slots_.empty()) {
+        return this->top_slot_++;
+      }
+      const SlotType kSlot = this->free_slots_.back();
+      this->free_slots_.pop_back();
+      return kSlot;
+    }
+
+    /// erase all values of the slot and recycle it
+    inline void RecycleSlot(const SlotType& slot) {
+      assert(slot < this->top_slot_);
+      assert(this->slot_count_ > 0);
+      for (auto& [key, column_list] : this->columns_) {
+        for (auto& column_ptr : column_list) {
+          column_ptr->EraseValue(slot);
+        }
+      }
+      this->free_slots_.emplace_back(slot);
+      this->slot_count_--;
+      return;
+    }
+
+    inline size_t SlotCount() const {
+      return this->slot_count_;
+    }
+
+    inline ColumnListContainerType& columns() {
+      return this->columns_;
+    }
+
+    inline const ColumnListContainerType& columns() const {
+      return this->columns_;
+    }
+
+    /// the column holding the value of the slot for that key,
+    /// nullptr if there is no such a value
+    inline AbstractColumn* FindValueColumn(const SlotType& slot,
+                                  const AttributeKeyType_& key) const {
+      auto it = this->columns_.find(key);
+      if (it == this->columns_.end()) {
+        return nullptr;
+      }
+      return FindValueColumn(slot, it->second);
+    }
+
+    static inline AbstractColumn* FindValueColumn(const SlotType& slot,
+                                       const ColumnList& column_list) {
+      for (const auto& column_ptr : column_list) {
+        if (column_ptr->HasValue(slot)) {
+          return column_ptr;
+        }
+      }
+      return nullptr;
+    }
+
+    template <typename ConcreteDataType>
+    inline ColumnPtr<ConcreteDataType> FindColumn(
+                   const AttributeKeyType_& key) const {
+      auto it = this->columns_.find(key);
+      if (it == this->columns_.end()) {
+        return nullptr;
+      }
+      const std::type_index kType(typeid(ConcreteDataType));
+      for (const auto& column_ptr : it->second) {
+        if (column_ptr->type() == kType) {
+          return static_cast<ColumnPtr<ConcreteDataType>>(column_ptr);
+        }
+      }
+      return nullptr;
+    }
+
+    /// find the column or add a new one if not exist
+    template <typename ConcreteDataType>
+    inline ColumnPtr<ConcreteDataType> GetColumn(
+                  const AttributeKeyType_& key) {
+      ColumnList& column_list = this->columns_[key];
+      const std::type_index kType(typeid(ConcreteDataType));
+      for (const auto& column_ptr : column_list) {
+        if (column_ptr->type() == kType) {
+          return static_cast<ColumnPtr<ConcreteDataType>>(column_ptr);
+        }
+      }
+      auto column_ptr = new ConcreteColumn<ConcreteDataType>(key);
+      column_list.emplace_back(column_ptr);
+      return column_ptr;
+    }
+
+   private:
+    ColumnListContainerType columns_;
+
+    std::vector<SlotType> free_slots_;
+
+    /// holds the maximum slot that has ever allocated
+    SlotType top_slot_;
+
+    /// holds the total slot currently in this group
+    size_t slot_count_;
+  };
+
+  using ColumnGroupType = ColumnGroup_;
+
+  template <bool is_const_>
+  class AttributeContentPtr_ {
+   private:
+    using AbstractColumnPtr = typename std::conditional<is_const_,
+                                            const AbstractColumn*,
+                                                  AbstractColumn*>::type;
+
+   protected:
+    inline bool IsNull() const {
+      return this->column_ptr_ == nullptr;
+    }
+
+   public:
+    AttributeContentPtr_() : column_ptr_(nullptr), slot_(0) {
+      return;
+    }
+
+    AttributeContentPtr_(AbstractColumnPtr column_ptr,
+                         const SlotType& slot)
+                          : column_ptr_(column_ptr),
+                                  slot_(slot) {
+      return;
+    }
+
+    inline const AttributeKeyType_& key() const {
+      assert(!this->IsNull());
+      return this->column_ptr_->key();
+    }
+
+    template <typename ConcreteDataType>
+    inline const ConcreteDataType& const_value() const {
+      assert(!this->IsNull());
+      return static_cast<ColumnConstPtr<ConcreteDataType>>(this->column_ptr_)
+                ->const_value(this->slot_);
+    }
+
+    template <typename ConcreteDataType>
+    inline auto& value() const {
+      assert(!this->IsNull());
+      if constexpr (is_const_) {
+        return this->template const_value<ConcreteDataType>();
+      }
+      else {
+        return static_cast<ColumnPtr<ConcreteDataType>>(this->column_ptr_)
+                  ->value(this->slot_);
+      }
+    }
+
+    inline std::string value_str() const {
+      assert(!this->IsNull());
+      return this->column_ptr_->value_str(this->slot_);
+    }
+
+    inline BasicDataType value_type() const {
+      assert(!this->IsNull());
+      return this->column_ptr_->value_type();
+    }
+
+    const char* value_type_name() const {
+      assert(!this->IsNull());
+      return EnumToString(this->value_type());
+    }
+
+   private:
+    AbstractColumnPtr column_ptr_;
+
+    SlotType slot_;
+  };
+
+  template <bool is_const_>
+  class AttributePtr_ : protected AttributeContentPtr_<is_const_> {
+   private:
+    using AttributeContentPtrType = AttributeContentPtr_<is_const_>;
+
+   public:
+    using AttributeContentPtrType::AttributeContentPtrType;
+
+    inline bool IsNull() const {
+      return AttributeContentPtrType::IsNull();
+    }
+
+    inline operator bool() const {
+      return !this->IsNull();
+    }
+
+    inline const AttributeContentPtrType* operator->() const {
+      const AttributeContentPtrType* temp_this_ptr = this;
+      return temp_this_ptr;
+    }
+  };
+
+  /// visits the keys that the slot has value for
+  template <bool is_const_>
+  class AttributeContentIterator_ {
+   private:
+    friend class Attribute_;
+
+    using ColumnListIteratorType
+        = typename ColumnListContainerType::const_iterator;
+
+    inline void ToValue() {
+      while (this->it_ != this->end_) {
+        this->column_ptr_ = ColumnGroupType::FindValueColumn(
+                                 this->slot_, this->it_->second);
+        if (this->column_ptr_ != nullptr) {
+          return;
+        }
+        ++this->it_;
+      }
+      this->column_ptr_ = nullptr;
+      return;
+    }
+
+   protected:
+    using ContentPtr = const AttributeContentIterator_*;
+
+    static constexpr bool kIsConst_ = is_const_;
+
+    inline bool IsDone() const {
+      return this->it_ == this->end_;
+    }
+
+    inline void ToNext() {
+      assert(!this->IsDone());
+      ++this->it_;
+      this->ToValue();
+      return;
+    }
+
+    inline ContentPtr content_ptr() const {
+      assert(!this->IsDone());
+      ContentPtr const temp_this_ptr = this;
+      return temp_this_ptr;
+    }
+
+   public:
+    AttributeContentIterator_() : it_(), end_(), slot_(0),
+                                  column_ptr_(nullptr) {
+      return;
+    }
+
+    AttributeContentIterator_(const SlotType& slot,
+                              const ColumnListIteratorType& begin,
+                              const ColumnListIteratorType& end)
+                                : it_(begin), end_(end), slot_(slot),
+                                  column_ptr_(nullptr) {
+      this->ToValue();
+      return;
+    }
+
+    inline const AttributeKeyType_& key() const {
+      assert(!this->IsDone());
+      return this->it_->first;
+    }
+
+    template <typename ConcreteDataType>
+    inline const ConcreteDataType& const_value() const {
+      assert(!this->IsDone());
+      return static_cast<ColumnConstPtr<ConcreteDataType>>(this->column_ptr_)
+                ->const_value(this->slot_);
+    }
+
+    template <typename ConcreteDataType,
+              bool judge = is_const_,
+              typename std::enable_if<!judge, bool>::type = false>
+    inline ConcreteDataType& value() const {
+      static_assert(judge == is_const_, "illegal usage of this method");
+      assert(!this->IsDone());
+      return static_cast<ColumnPtr<ConcreteDataType>>(this->column_ptr_)
+                ->value(this->slot_);
+    }
+
+    inline std::string value_str() const {
+      assert(!this->IsDone());
+      return this->column_ptr_->value_str(this->slot_);
+    }
+
+    inline BasicDataType value_type() const {
+      assert(!this->IsDone());
+      return this->column_ptr_->value_type();
+    }
+
+    const char* value_type_name() const {
+      assert(!this->IsDone());
+      return EnumToString(this->value_type());
+    }
+
+   private:
+    ColumnListIteratorType it_;
+
+    ColumnListIteratorType end_;
+
+    SlotType slot_;
+
+    AbstractColumn* column_ptr_;
+  };
+
+  using AttributeContentIterator      = AttributeContentIterator_<false>;
+  using AttributeContentConstIterator = AttributeContentIterator_< true>;
+
+ public:
+  using AttributeKeyType = AttributeKeyType_;
+
+  using AttributeIterator      = Iterator_<AttributeContentIterator>;
+  using AttributeConstIterator = Iterator_<AttributeContentConstIterator>;
+
+  using AttributePtr      = AttributePtr_<false>;
+  using AttributeConstPtr = AttributePtr_< true>;
+
+  Attribute_(const GroupKeyType_& group_key) {
+    auto [group_it, ret] = Attribute_::column_group_ptr_container_
+                                      .emplace(group_key, nullptr);
+    if (ret) {
+      group_it->second = new ColumnGroupType();
+    }
+    this->column_group_ptr_ = group_it->second;
+    this->slot_ = this->column_group_ptr_->AllocSlot();
+    return;
+  }
+
+  ~Attribute_() {
+    this->column_group_ptr_->RecycleSlot(this->slot_);
+    if (this->column_group_ptr_->SlotCount() != 0) {
+      return;
+    }
+    /// this group is empty, should be released
+    for (auto it  = Attribute_::column_group_ptr_container_.begin();
+              it != Attribute_::column_group_ptr_container_. end ();
+              it++) {
+      if (it->second == this->column_group_ptr_) {
+        delete it->second;
+        Attribute_::column_group_ptr_container_.erase(it);
+        return;
+      }
+    }
+    /// should had found the corresponds column group pointer
+    assert(false);
+    return;
+  }
+
+  /// the slot of this container in its group, the index of
+  /// its values in the columns
+  inline const SlotType& slot() const {
+    return this->slot_;
+  }
+
+  inline enum BasicDataType attribute_value_type(
+                      const AttributeKeyType_& key) const {
+    auto column_ptr = this->column_group_ptr_
+                          ->FindValueColumn(this->slot_, key);
+    assert(column_ptr != nullptr);
+    return column_ptr->value_type();
+  }
+
+  inline const char* attribute_value_type_name(
+                      const AttributeKeyType_& key) const {
+    return EnumToString(this->attribute_value_type(key));
+  }
+
+  inline AttributeIterator AttributeBegin() {
+    return AttributeIterator(this->slot_,
+                             this->column_group_ptr_->columns().cbegin(),
+                             this->column_group_ptr_->columns().cend());
+  }
+
+  inline AttributeConstIterator AttributeBegin() const {
+    return AttributeConstIterator(this->slot_,
+                             this->column_group_ptr_->columns().cbegin(),
+                             this->column_group_ptr_->columns().cend());
+  }
+
+  inline AttributePtr FindAttribute(const AttributeKeyType_& key) {
+    auto column_ptr = this->column_group_ptr_
+                          ->FindValueColumn(this->slot_, key);
+    if (column_ptr == nullptr) {
+      return AttributePtr();
+    }
+    return AttributePtr(column_ptr, this->slot_);
+  }
+
+  inline AttributeConstPtr FindAttribute(const AttributeKeyType_& key) const {
+    auto column_ptr = this->column_group_ptr_
+                          ->FindValueColumn(this->slot_, key);
+    if (column_ptr == nullptr) {
+      return AttributeConstPtr();
+    }
+    return AttributeConstPtr(column_ptr, this->slot_);
+  }
+
+  /// the column of the given key and value type shared by the containers
+  /// in the same group, nullptr if not exist. It can be held to access
+  /// the attribute of these containers without looking up the key
+  template <typename ConcreteDataType>
+  inline ColumnPtr<ConcreteDataType> FindColumn(
+                   const AttributeKeyType_& key) {
+    return this->column_group_ptr_
+               ->template FindColumn<ConcreteDataType>(key);
+  }
+
+  template <typename ConcreteDataType>
+  inline ColumnConstPtr<ConcreteDataType> FindColumn(
+                   const AttributeKeyType_& key) const {
+    return this->column_group_ptr_
+               ->template FindColumn<ConcreteDataType>(key);
+  }
+
+  template <typename ConcreteDataType>
+  inline bool HasAttribute(
+        ColumnConstPtr<ConcreteDataType> column_ptr) const {
+    return column_ptr != nullptr
+        && column_ptr->HasValue(this->slot_);
+  }
+
+  template <typename ConcreteDataType>
+  inline ConcreteDataType& attribute(const AttributeKeyType_& key) {
+    auto column_ptr = this->template FindColumn<ConcreteDataType>(key);
+    assert(column_ptr != nullptr);
+    return column_ptr->value(this->slot_);
+  }
+
+  template <typename ConcreteDataType>
+  inline ConcreteDataType& attribute(
+        ColumnPtr<ConcreteDataType> column_ptr) {
+    assert(column_ptr != nullptr);
+    return column_ptr->value(this->slot_);
+  }
+
+  template <typename ConcreteDataType>
+  inline const ConcreteDataType& const_attribute(
+                      const AttributeKeyType_& key) const {
+    auto column_ptr = this->template FindColumn<ConcreteDataType>(key);
+    assert(column_ptr != nullptr);
+    return column_ptr->const_value(this->slot_);
+  }
+
+  template <typename ConcreteDataType>
+  inline const ConcreteDataType& const_attribute(
+        ColumnConstPtr<ConcreteDataType> column_ptr) const {
+    assert(column_ptr != nullptr);
+    return column_ptr->const_value(this->slot_);
+  }
+
+  template <typename ConcreteDataType>
+  inline std::pair<AttributePtr, bool>
+                AddAttribute(const AttributeKeyType_& key,
+                             const ConcreteDataType& value) {
+    auto column_ptr = this->column_group_ptr_
+                          ->FindValueColumn(this->slot_, key);
+    if (column_ptr != nullptr) {
+      /// already has value for this key
+      return std::make_pair(AttributePtr(column_ptr, this->slot_), false);
+    }
+    auto concrete_column_ptr = this->column_group_ptr_
+                                   ->template GetColumn<ConcreteDataType>(key);
+    const bool kAddValueRet = concrete_column_ptr->AddValue(this->slot_,
+                                                            value);
+    assert(kAddValueRet);
+    return std::make_pair(AttributePtr(concrete_column_ptr, this->slot_),
+                          kAddValueRet);
+  }
+
+  inline std::pair<AttributePtr, bool> AddAttribute(
+                    const AttributeKeyType_& key,
+                    const enum BasicDataType& data_type,
+                    const std::string& value_str) {
+    switch (data_type) {
+      case BasicDataType::kTypeString:
+        return this->AddAttribute<std::string>(key, value_str);
+      case BasicDataType::kTypeInt:
+        return this->AddAttribute<int>(key, std::stoi(value_str));
+      case BasicDataType::kTypeInt64:
+        return this->AddAttribute<int64_t>(key, std::stoll(value_str));
+      case BasicDataType::kTypeFloat:
+        return this->AddAttribute<float>(key, std::stof(value_str));
+      case BasicDataType::kTypeDouble:
+        return this->AddAttribute<double>(key, std::stod(value_str));
+      case BasicDataType::kTypeDateTime:
+        return this->AddAttribute<DateTime>(key, DateTime(value_str));
+      case BasicDataType::kTypeUnknown:
+      default:
+        break;
+    }
+    return std::make_pair(AttributePtr(), false);
+  }
+
+  template <typename ConcreteDataType>
+  inline std::pair<AttributePtr, bool> SetAttribute(
+                         const AttributeKeyType_& key,
+                         const ConcreteDataType& value) {
+    auto column_ptr = this->column_group_ptr_
+                          ->FindValueColumn(this->slot_, key);
+    if (column_ptr == nullptr) {
+      /// does not have value for this key
+      return std::make_pair(AttributePtr(), false);
+    }
+    auto concrete_column_ptr = this->column_group_ptr_
+                                   ->template GetColumn<ConcreteDataType>(key);
+    if (concrete_column_ptr == column_ptr) {
+      /// the new value has the same type
+      concrete_column_ptr->SetValue(this->slot_, value);
+      return std::make_pair(AttributePtr(concrete_column_ptr, this->slot_),
+                            true);
+    }
+    /// the value is moved into the column of the new type
+    column_ptr->EraseValue(this->slot_);
+    concrete_column_ptr->AddValue(this->slot_, value);
+    return std::make_pair(AttributePtr(concrete_column_ptr, this->slot_),
+                          true);
+  }
+
+  inline AttributeIterator EraseAttribute(
+   const AttributeIterator& attribute_iterator) {
+    const void* const ptr = &attribute_iterator;
+    const AttributeContentIterator* attr_it_ptr
+      = static_cast<const AttributeContentIterator*>(ptr);
+    assert(attr_it_ptr->slot_ == this->slot_);
+    assert(!attr_it_ptr->IsDone());
+    attr_it_ptr->column_ptr_->EraseValue(this->slot_);
+    auto next_it = attr_it_ptr->it_;
+    ++next_it;
+    return AttributeIterator(this->slot_, next_it,
+                             this->column_group_ptr_->columns().cend());
+  }
+
+  /// return 1 if erased successfully, 0 if not
+  inline size_t EraseAttribute(const AttributeKeyType_& key) {
+    auto column_ptr = this->column_group_ptr_
+                          ->FindValueColumn(this->slot_, key);
+    if (column_ptr == nullptr) {
+      return 0;
+    }
+    column_ptr->EraseValue(this->slot_);
+    return 1;
+  }
+
+ private:
+  inline static std::map<GroupKeyType_, ColumnGroupType*>
+                column_group_ptr_container_;
+
+  /// the index of this container in the columns of the group
+  SlotType slot_;
+
+  ColumnGroupType* column_group_ptr_;
+};
+
 };
 
 #endif ///_ATTRIBUTE_H
\ No newline at end of file
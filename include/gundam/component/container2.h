@@ -218,6 +218,20 @@ class TreeDict {
     return container_.emplace(key, ValueType(std::forward<VArgs>(vargs)...));
   }
 
+  // inserts the (key, value) pairs in the order of the batch, inserted[i]
+  // is false if the key of batch[i] already exists in the dict or in the
+  // batch before it, the keys in ascending order are inserted in O(1) each
+  void InsertBatch(std::vector<std::pair<KeyType, ValueType>>& batch,
+                   std::vector<bool>& inserted) {
+    inserted.assign(batch.size(), false);
+    for (size_t idx = 0; idx < batch.size(); idx++) {
+      const size_t kOldSize = container_.size();
+      container_.emplace_hint(container_.end(), std::move(batch[idx]));
+      inserted[idx] = container_.size() != kOldSize;
+    }
+    return;
+  }
+
   iterator Find(const KeyType& key) { return container_.find(key); }
 
   const_iterator Find(const KeyType& key) const { return container_.find(key); }
@@ -323,6 +337,11 @@ class SortedVectorDict {
     return pair.first < key;
   }
 
+  static bool ComparePair(const std::pair<KeyType, ValueType>& pair0,
+                          const std::pair<KeyType, ValueType>& pair1) {
+    return pair0.first < pair1.first;
+  }
+
  public:
   using value_type = typename InnerContainerType::value_type;
 
@@ -355,6 +374,54 @@ class SortedVectorDict {
         true);
   }
 
+  // inserts the (key, value) pairs together, inserted[i] is false if
+  // the key of batch[i] already exists in the dict or in the batch
+  // before it, the batch is sorted, appended and then merged into the
+  // dict once instead of moving O(n) pairs for each of them
+  void InsertBatch(std::vector<std::pair<KeyType, ValueType>>& batch,
+                   std::vector<bool>& inserted) {
+    inserted.assign(batch.size(), false);
+    std::vector<size_t> order(batch.size());
+    for (size_t idx = 0; idx < batch.size(); idx++) order[idx] = idx;
+    if (!std::is_sorted(batch.begin(), batch.end(), ComparePair)) {
+      std::stable_sort(order.begin(), order.end(),
+                       [&batch](size_t idx0, size_t idx1) {
+                         return batch[idx0].first < batch[idx1].first;
+                       });
+    }
+    const size_t kOldSize = container_.size();
+    if (container_.capacity() < kOldSize + batch.size()) {
+      container_.reserve(std::max(kOldSize + batch.size(),
+                                  container_.capacity() * 2));
+    }
+    // the keys are visited in ascending order, the search in the
+    // pairs already in the dict continues from the last position
+    size_t old_pos = 0;
+    for (const auto& idx : order) {
+      if (container_.size() > kOldSize
+       && !(container_.back().first < batch[idx].first)) {
+        // duplicated in the batch
+        continue;
+      }
+      old_pos = std::lower_bound(container_.begin() + old_pos,
+                                 container_.begin() + kOldSize,
+                                 batch[idx].first, Compare)
+              - container_.begin();
+      if (old_pos < kOldSize
+       && container_[old_pos].first == batch[idx].first) {
+        continue;
+      }
+      container_.emplace_back(std::move(batch[idx]));
+      inserted[idx] = true;
+    }
+    if (kOldSize > 0 && container_.size() > kOldSize
+     && container_[kOldSize].first < container_[kOldSize - 1].first) {
+      std::inplace_merge(container_.begin(), container_.begin() + kOldSize,
+                         container_.end(), ComparePair);
+    }
+    return;
+  }
+
   iterator Find(const KeyType& key) {
     auto it =
         std::lower_bound(container_.begin(), container_.end(), key, Compare);
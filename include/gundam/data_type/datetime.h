@@ -45,6 +45,8 @@ class DateTime {
     return std::string(str);
   }
 
+  time_t to_time_t() const { return t_; }
+
   friend std::ostream& operator<<(std::ostream& out, const DateTime& b) {
     out << b.to_string();
     return out;
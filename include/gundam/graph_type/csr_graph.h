@@ -0,0 +1,1010 @@
+#ifndef _GUNDAM_GRAPH_TYPE_CSR_GRAPH_H
+#define _GUNDAM_GRAPH_TYPE_CSR_GRAPH_H
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gundam/component/attribute.h"
+#include "gundam/component/iterator2.h"
+
+#include "gundam/graph_type/graph_parameter.h"
+
+#include "gundam/type_getter/graph_parameter_getter.h"
+
+#include "gundam/type_getter/vertex_id.h"
+#include "gundam/type_getter/vertex_label.h"
+#include "gundam/type_getter/vertex_handle.h"
+#include "gundam/type_getter/vertex_attribute_handle.h"
+
+#include "gundam/type_getter/edge_id.h"
+#include "gundam/type_getter/edge_label.h"
+#include "gundam/type_getter/edge_handle.h"
+#include "gundam/type_getter/edge_attribute_handle.h"
+
+namespace GUNDAM {
+
+namespace _csr_graph {
+
+template <class IteratorType, class ValueType>
+struct LabelGroupCast {
+  constexpr ValueType &operator()(IteratorType &it) const {
+    return it->label_;
+  }
+};
+
+};  // namespace _csr_graph
+
+// immutable graph in compressed sparse row layout, the topology
+// is frozen once constructed, only the attributes can be modified
+//
+// all vertices are held in one array sorted by (label, id), all
+// edges are held in one array sorted by their source vertex, the
+// adjacent edges of each vertex are grouped by
+//    (direction, edge label, adjacent vertex label)
+// and stored contiguously, so that all neighbor scans are sequential
+template <class VertexIDType, class VertexLabelType, class VertexAttributeKeyType,
+          class   EdgeIDType, class   EdgeLabelType, class   EdgeAttributeKeyType>
+class CSRGraph;
+
+template <class VertexIDType, class VertexLabelType, class VertexAttributeKeyType,
+          class   EdgeIDType, class   EdgeLabelType, class   EdgeAttributeKeyType>
+class CSRGraph {
+ public:
+  class _GraphParameter : public GraphParameterBase {
+   public:
+    static constexpr bool vertex_has_attribute = true;
+
+    static constexpr bool edge_has_attribute = true;
+
+    static constexpr bool graph_level_vertex_label_index = true;
+
+    static constexpr bool vertex_level_edge_label_index = true;
+
+    static constexpr bool graph_level_edge_iterator = true;
+
+    static constexpr bool graph_level_count_vertex = true;
+
+    static constexpr bool graph_level_count_edge = true;
+  };
+
+ private:
+  class VertexData;
+
+  class EdgeData;
+
+  class LabelGroup;
+
+ private:
+  friend class VertexAttributeHandle<CSRGraph>;
+  friend class VertexAttributeHandle<const CSRGraph>;
+
+  friend class EdgeAttributeHandle<CSRGraph>;
+  friend class EdgeAttributeHandle<const CSRGraph>;
+
+  using VertexAttributePtr           = typename VertexData::AttributePtr;
+  using VertexAttributeConstPtr      = typename VertexData::AttributeConstPtr;
+  using   EdgeAttributePtr           = typename   EdgeData::AttributePtr;
+  using   EdgeAttributeConstPtr      = typename   EdgeData::AttributeConstPtr;
+
+  // the adjacent edges of one vertex with the same direction
+  // and the same edge label
+  class LabelGroup {
+   private:
+    friend class CSRGraph;
+
+    template <class, class>
+    friend struct _csr_graph::LabelGroupCast;
+
+    EdgeLabelType label_;
+
+    // sorted by (adjacent vertex label, adjacent vertex, edge id)
+    EdgeData **edge_begin_,
+             **edge_end_;
+
+    // distinct adjacent vertexes, sorted by (label, handle)
+    VertexData **vertex_begin_,
+               **vertex_end_;
+  };
+
+  class VertexData
+      : public Attribute_<AttributeType::kSeparated,
+                          false, // not const
+                          std::pair<VertexLabelType, bool>,
+                          VertexAttributeKeyType,
+                          ContainerType::Vector,
+                          SortType::Default> {
+   private:
+    friend class CSRGraph;
+
+    // compare the adjacent vertex of an edge with (label, handle)
+    template <bool is_out>
+    struct AdjacentVertexCompare {
+      using KeyType = std::pair<VertexLabelType, const VertexData *>;
+
+      static inline const VertexData *Adjacent(const EdgeData *e) {
+        return is_out ? e->dst_ : e->src_;
+      }
+
+      bool operator()(const EdgeData *e, const KeyType &key) const {
+        const VertexData *v = Adjacent(e);
+        if (v->label_ != key.first) {
+          return v->label_ < key.first;
+        }
+        return std::less<const VertexData *>()(v, key.second);
+      }
+
+      bool operator()(const KeyType &key, const EdgeData *e) const {
+        const VertexData *v = Adjacent(e);
+        if (key.first != v->label_) {
+          return key.first < v->label_;
+        }
+        return std::less<const VertexData *>()(key.second, v);
+      }
+    };
+
+    struct LabelGroupCompare {
+      bool operator()(const LabelGroup &group,
+                      const EdgeLabelType &edge_label) const {
+        return group.label_ < edge_label;
+      }
+    };
+
+   public:
+    using GraphType = CSRGraph;
+
+    using IDType = VertexIDType;
+
+    using LabelType = VertexLabelType;
+
+    using AttributeKeyType = VertexAttributeKeyType;
+
+    using EdgeIterator = GIterator<EdgeData **, EdgeData, PointerCast>;
+
+    using EdgeConstIterator =
+        GIterator<EdgeData *const *, const EdgeData, PointerCast>;
+
+    using VertexIterator = GIterator<VertexData **, VertexData, PointerCast>;
+
+    using VertexConstIterator =
+        GIterator<VertexData *const *, const VertexData, PointerCast>;
+
+    using EdgeLabelConstIterator =
+        GIterator<const LabelGroup *, const EdgeLabelType,
+                  _csr_graph::LabelGroupCast>;
+
+    VertexData(const IDType &id, const LabelType &label)
+        : id_(id), label_(label),
+          out_edge_begin_(nullptr), out_edge_end_(nullptr),
+           in_edge_begin_(nullptr),  in_edge_end_(nullptr),
+          out_group_begin_(nullptr), out_group_end_(nullptr),
+           in_group_begin_(nullptr),  in_group_end_(nullptr),
+          out_vertex_count_(0),
+           in_vertex_count_(0) {}
+
+    const IDType &id() const { return id_; }
+
+    const VertexLabelType &label() const { return label_; }
+
+    size_t CountOutEdge() const { return out_edge_end_ - out_edge_begin_; }
+
+    size_t CountOutEdgeLabel() const {
+      return out_group_end_ - out_group_begin_;
+    }
+
+    size_t CountOutEdge(const EdgeLabelType &edge_label) const {
+      const LabelGroup *group = FindGroup(out_group_begin_,
+                                          out_group_end_, edge_label);
+      if (!group) return 0;
+      return group->edge_end_ - group->edge_begin_;
+    }
+
+    size_t CountOutEdge(const EdgeLabelType &edge_label,
+                        const VertexData *vertex_ptr) const {
+      auto [first, last] = AdjacentRange<true>(
+          out_group_begin_, out_group_end_, edge_label, vertex_ptr);
+      return last - first;
+    }
+
+    size_t CountOutVertex() const { return out_vertex_count_; }
+
+    size_t CountOutVertex(const EdgeLabelType &edge_label) const {
+      const LabelGroup *group = FindGroup(out_group_begin_,
+                                          out_group_end_, edge_label);
+      if (!group) return 0;
+      return group->vertex_end_ - group->vertex_begin_;
+    }
+
+    size_t CountInEdge() const { return in_edge_end_ - in_edge_begin_; }
+
+    size_t CountInEdgeLabel() const {
+      return in_group_end_ - in_group_begin_;
+    }
+
+    size_t CountInEdge(const EdgeLabelType &edge_label) const {
+      const LabelGroup *group = FindGroup(in_group_begin_,
+                                          in_group_end_, edge_label);
+      if (!group) return 0;
+      return group->edge_end_ - group->edge_begin_;
+    }
+
+    size_t CountInEdge(const EdgeLabelType &edge_label,
+                       const VertexData *vertex_ptr) const {
+      auto [first, last] = AdjacentRange<false>(
+          in_group_begin_, in_group_end_, edge_label, vertex_ptr);
+      return last - first;
+    }
+
+    size_t CountInVertex() const { return in_vertex_count_; }
+
+    size_t CountInVertex(const EdgeLabelType &edge_label) const {
+      const LabelGroup *group = FindGroup(in_group_begin_,
+                                          in_group_end_, edge_label);
+      if (!group) return 0;
+      return group->vertex_end_ - group->vertex_begin_;
+    }
+
+    EdgeIterator OutEdgeBegin() {
+      return {out_edge_begin_, out_edge_end_};
+    }
+
+    EdgeConstIterator OutEdgeBegin() const {
+      return {static_cast<EdgeData *const *>(out_edge_begin_),
+              static_cast<EdgeData *const *>(out_edge_end_)};
+    }
+
+    EdgeIterator OutEdgeBegin(const EdgeLabelType &edge_label) {
+      LabelGroup *group = FindGroup(out_group_begin_,
+                                    out_group_end_, edge_label);
+      if (!group) return {};
+      return {group->edge_begin_, group->edge_end_};
+    }
+
+    EdgeConstIterator OutEdgeBegin(const EdgeLabelType &edge_label) const {
+      const LabelGroup *group = FindGroup(out_group_begin_,
+                                          out_group_end_, edge_label);
+      if (!group) return {};
+      return {static_cast<EdgeData *const *>(group->edge_begin_),
+              static_cast<EdgeData *const *>(group->edge_end_)};
+    }
+
+    EdgeIterator OutEdgeBegin(const EdgeLabelType &edge_label,
+                              const VertexData *vertex_ptr) {
+      auto [first, last] = AdjacentRange<true>(
+          out_group_begin_, out_group_end_, edge_label, vertex_ptr);
+      return {first, last};
+    }
+
+    EdgeConstIterator OutEdgeBegin(const EdgeLabelType &edge_label,
+                                   const VertexData *vertex_ptr) const {
+      auto [first, last] = AdjacentRange<true>(
+          out_group_begin_, out_group_end_, edge_label, vertex_ptr);
+      return {static_cast<EdgeData *const *>(first),
+              static_cast<EdgeData *const *>(last)};
+    }
+
+    VertexIterator OutVertexBegin(const EdgeLabelType &edge_label) {
+      LabelGroup *group = FindGroup(out_group_begin_,
+                                    out_group_end_, edge_label);
+      if (!group) return {};
+      return {group->vertex_begin_, group->vertex_end_};
+    }
+
+    VertexConstIterator OutVertexBegin(const EdgeLabelType &edge_label) const {
+      const LabelGroup *group = FindGroup(out_group_begin_,
+                                          out_group_end_, edge_label);
+      if (!group) return {};
+      return {static_cast<VertexData *const *>(group->vertex_begin_),
+              static_cast<VertexData *const *>(group->vertex_end_)};
+    }
+
+    EdgeLabelConstIterator OutEdgeLabelBegin() const {
+      return {static_cast<const LabelGroup *>(out_group_begin_),
+              static_cast<const LabelGroup *>(out_group_end_)};
+    }
+
+    EdgeIterator InEdgeBegin() {
+      return {in_edge_begin_, in_edge_end_};
+    }
+
+    EdgeConstIterator InEdgeBegin() const {
+      return {static_cast<EdgeData *const *>(in_edge_begin_),
+              static_cast<EdgeData *const *>(in_edge_end_)};
+    }
+
+    EdgeIterator InEdgeBegin(const EdgeLabelType &edge_label) {
+      LabelGroup *group = FindGroup(in_group_begin_,
+                                    in_group_end_, edge_label);
+      if (!group) return {};
+      return {group->edge_begin_, group->edge_end_};
+    }
+
+    EdgeConstIterator InEdgeBegin(const EdgeLabelType &edge_label) const {
+      const LabelGroup *group = FindGroup(in_group_begin_,
+                                          in_group_end_, edge_label);
+      if (!group) return {};
+      return {static_cast<EdgeData *const *>(group->edge_begin_),
+              static_cast<EdgeData *const *>(group->edge_end_)};
+    }
+
+    EdgeIterator InEdgeBegin(const EdgeLabelType &edge_label,
+                             const VertexData *vertex_ptr) {
+      auto [first, last] = AdjacentRange<false>(
+          in_group_begin_, in_group_end_, edge_label, vertex_ptr);
+      return {first, last};
+    }
+
+    EdgeConstIterator InEdgeBegin(const EdgeLabelType &edge_label,
+                                  const VertexData *vertex_ptr) const {
+      auto [first, last] = AdjacentRange<false>(
+          in_group_begin_, in_group_end_, edge_label, vertex_ptr);
+      return {static_cast<EdgeData *const *>(first),
+              static_cast<EdgeData *const *>(last)};
+    }
+
+    VertexIterator InVertexBegin(const EdgeLabelType &edge_label) {
+      LabelGroup *group = FindGroup(in_group_begin_,
+                                    in_group_end_, edge_label);
+      if (!group) return {};
+      return {group->vertex_begin_, group->vertex_end_};
+    }
+
+    VertexConstIterator InVertexBegin(const EdgeLabelType &edge_label) const {
+      const LabelGroup *group = FindGroup(in_group_begin_,
+                                          in_group_end_, edge_label);
+      if (!group) return {};
+      return {static_cast<VertexData *const *>(group->vertex_begin_),
+              static_cast<VertexData *const *>(group->vertex_end_)};
+    }
+
+    EdgeLabelConstIterator InEdgeLabelBegin() const {
+      return {static_cast<const LabelGroup *>(in_group_begin_),
+              static_cast<const LabelGroup *>(in_group_end_)};
+    }
+
+   private:
+    static inline LabelGroup *FindGroup(LabelGroup *group_begin,
+                                        LabelGroup *group_end,
+                                        const EdgeLabelType &edge_label) {
+      // the number of distinct edge labels on one vertex is
+      // small in most cases, binary search is still used for
+      // the vertexes with many edge labels
+      LabelGroup *it = std::lower_bound(group_begin, group_end,
+                                        edge_label, LabelGroupCompare());
+      if (it == group_end || it->label_ != edge_label) {
+        return nullptr;
+      }
+      return it;
+    }
+
+    template <bool is_out>
+    static inline std::pair<EdgeData **, EdgeData **> AdjacentRange(
+        LabelGroup *group_begin, LabelGroup *group_end,
+        const EdgeLabelType &edge_label, const VertexData *vertex_ptr) {
+      LabelGroup *group = FindGroup(group_begin, group_end, edge_label);
+      if (!group || !vertex_ptr) {
+        return std::pair<EdgeData **, EdgeData **>(nullptr, nullptr);
+      }
+      return std::equal_range(
+          group->edge_begin_, group->edge_end_,
+          typename AdjacentVertexCompare<is_out>::KeyType(vertex_ptr->label_,
+                                                          vertex_ptr),
+          AdjacentVertexCompare<is_out>());
+    }
+
+    VertexIDType id_;
+    VertexLabelType label_;
+
+    EdgeData **out_edge_begin_,
+             **out_edge_end_;
+    EdgeData ** in_edge_begin_,
+             ** in_edge_end_;
+
+    LabelGroup *out_group_begin_,
+               *out_group_end_;
+    LabelGroup * in_group_begin_,
+               * in_group_end_;
+
+    size_t out_vertex_count_,
+            in_vertex_count_;
+  };
+
+  class EdgeData
+      : public Attribute_<AttributeType::kSeparated,
+                          false, // not const
+                          std::pair<EdgeLabelType, bool>,
+                          EdgeAttributeKeyType,
+                          ContainerType::Vector,
+                          SortType::Default> {
+   private:
+    friend class CSRGraph;
+
+   public:
+    using GraphType = CSRGraph;
+
+    using IDType = EdgeIDType;
+
+    using LabelType = EdgeLabelType;
+
+    using AttributeKeyType = EdgeAttributeKeyType;
+
+    EdgeData(const EdgeIDType &id, const EdgeLabelType &label, VertexData *src,
+             VertexData *dst)
+        : id_(id), label_(label), src_(src), dst_(dst) {}
+
+    const EdgeIDType &id() const { return id_; }
+
+    const EdgeLabelType &label() const { return label_; }
+
+    const VertexIDType &src_id() const { return src_->id(); }
+
+    const VertexIDType &dst_id() const { return dst_->id(); }
+
+    VertexData *src_handle() { return src_; }
+
+    VertexData *dst_handle() { return dst_; }
+
+    const VertexData *src_handle() const { return this->const_src_handle(); }
+
+    const VertexData *dst_handle() const { return this->const_dst_handle(); }
+
+    const VertexData *const_src_handle() const { return src_; }
+
+    const VertexData *const_dst_handle() const { return dst_; }
+
+   private:
+    EdgeIDType id_;
+    EdgeLabelType label_;
+    VertexData *src_;
+    VertexData *dst_;
+  };
+
+ private:
+  friend class VertexHandle<CSRGraph>;
+  friend class VertexHandle<const CSRGraph>;
+
+  friend class EdgeHandle<CSRGraph>;
+  friend class EdgeHandle<const CSRGraph>;
+
+  friend class VertexID<CSRGraph>;
+  friend class VertexLabel<const CSRGraph>;
+
+  friend class EdgeID<CSRGraph>;
+  friend class EdgeLabel<const CSRGraph>;
+
+ protected:
+  using VertexPtr = VertexData *;
+
+  using VertexConstPtr = const VertexData *;
+
+  using EdgePtr = EdgeData *;
+
+  using EdgeConstPtr = const EdgeData *;
+
+ public:
+  using VertexType = VertexData;
+
+  using EdgeType = EdgeData;
+
+  using VertexCounterType = size_t;
+
+  using VertexIterator = GIterator<VertexData *, VertexData, DefaultCast>;
+
+  using VertexConstIterator =
+      GIterator<const VertexData *, const VertexData, DefaultCast>;
+
+  using EdgeIterator = GIterator<EdgeData *, EdgeData, DefaultCast>;
+
+  using EdgeConstIterator =
+      GIterator<const EdgeData *, const EdgeData, DefaultCast>;
+
+  // raw records to build the graph from
+  //    vertex: <id, label>
+  //      edge: <id, src id, dst id, label>
+  using VertexRecord = std::pair<VertexIDType, VertexLabelType>;
+
+  using EdgeRecord = std::tuple<EdgeIDType, VertexIDType,
+                                VertexIDType, EdgeLabelType>;
+
+  CSRGraph() = default;
+
+  // build from the raw records, the vertexes with duplicated id
+  // and the edges with duplicated id or with a not existing
+  // src/dst vertex are ignored, which is the same as calling
+  // AddVertex/AddEdge one-by-one on the mutable graph types
+  CSRGraph(std::vector<VertexRecord> vertex_records,
+           std::vector<  EdgeRecord>   edge_records) {
+    this->Build(std::move(vertex_records),
+                std::move(  edge_records));
+  }
+
+  // build from any graph type in GUNDAM, the attributes
+  // are copied if both graph types have them
+  template <typename GraphType>
+  explicit CSRGraph(const GraphType &other) {
+    this->BuildFrom(other);
+  }
+
+  explicit CSRGraph(const CSRGraph &other) {
+    this->BuildFrom(other);
+  }
+
+  CSRGraph(CSRGraph &&) = default;
+
+  CSRGraph &operator=(const CSRGraph &other) {
+    if (this == &other) {
+      return *this;
+    }
+    this->Clear();
+    this->BuildFrom(other);
+    return *this;
+  }
+
+  CSRGraph &operator=(CSRGraph &&) = default;
+
+  size_t CountVertex() const { return vertices_.size(); }
+
+  size_t CountVertex(const typename VertexType::LabelType &label) const {
+    auto [first, last] = this->LabelRange(label);
+    return last - first;
+  }
+
+  size_t CountEdge() const { return edges_.size(); }
+
+  VertexPtr FindVertex(const typename VertexType::IDType &id) {
+    return const_cast<VertexPtr>(
+        static_cast<const CSRGraph *>(this)->FindVertex(id));
+  }
+
+  VertexConstPtr FindVertex(const typename VertexType::IDType &id) const {
+    auto it = std::lower_bound(
+        vertex_id_index_.cbegin(), vertex_id_index_.cend(), id,
+        [](const VertexData *v, const VertexIDType &vertex_id) {
+          return v->id_ < vertex_id;
+        });
+    if (it == vertex_id_index_.cend() || (*it)->id_ != id) {
+      return nullptr;
+    }
+    return *it;
+  }
+
+  VertexIterator VertexBegin() {
+    return VertexIterator(vertices_.data(),
+                          vertices_.data() + vertices_.size());
+  }
+
+  VertexConstIterator VertexBegin() const {
+    return VertexConstIterator(vertices_.data(),
+                               vertices_.data() + vertices_.size());
+  }
+
+  VertexIterator VertexBegin(const typename VertexType::LabelType &label) {
+    auto [first, last] = this->LabelRange(label);
+    return VertexIterator(const_cast<VertexData *>(first),
+                          const_cast<VertexData *>(last));
+  }
+
+  VertexConstIterator VertexBegin(
+      const typename VertexType::LabelType &label) const {
+    auto [first, last] = this->LabelRange(label);
+    return VertexConstIterator(first, last);
+  }
+
+  EdgePtr FindEdge(const typename EdgeType::IDType &id) {
+    return const_cast<EdgePtr>(
+        static_cast<const CSRGraph *>(this)->FindEdge(id));
+  }
+
+  EdgeConstPtr FindEdge(const typename EdgeType::IDType &id) const {
+    auto it = std::lower_bound(
+        edge_id_index_.cbegin(), edge_id_index_.cend(), id,
+        [](const EdgeData *e, const EdgeIDType &edge_id) {
+          return e->id_ < edge_id;
+        });
+    if (it == edge_id_index_.cend() || (*it)->id_ != id) {
+      return nullptr;
+    }
+    return *it;
+  }
+
+  // the edges are visited in the order of their source vertexes
+  EdgeIterator EdgeBegin() {
+    return EdgeIterator(edges_.data(), edges_.data() + edges_.size());
+  }
+
+  EdgeConstIterator EdgeBegin() const {
+    return EdgeConstIterator(edges_.data(), edges_.data() + edges_.size());
+  }
+
+  // build from the arrays that are already in the order held in this
+  // graph, nothing is sorted, deduplicated or looked up by id, used to
+  // load the snapshot written by WriteGraphSnapshot
+  //   vertex_id/vertex_label:  sorted by (label, id)
+  //   edge_*:                  sorted by (src, edge label, dst label, dst, id)
+  //   edge_src/edge_dst:       index of the vertex in vertex_id
+  //   in_edge:                 index of the edge sorted by
+  //                            (dst, edge label, src label, src, id)
+  //   vertex_id_order/edge_id_order: index sorted by id
+  void BuildSorted(size_t vertex_num,
+                   const VertexIDType    *vertex_id,
+                   const VertexLabelType *vertex_label,
+                   const uint64_t        *vertex_id_order,
+                   size_t edge_num,
+                   const EdgeIDType    *edge_id,
+                   const EdgeLabelType *edge_label,
+                   const uint64_t      *edge_src,
+                   const uint64_t      *edge_dst,
+                   const uint64_t      *edge_id_order,
+                   const uint64_t      *in_edge) {
+    this->Clear();
+
+    vertices_.reserve(vertex_num);
+    for (size_t i = 0; i < vertex_num; i++) {
+      vertices_.emplace_back(vertex_id[i], vertex_label[i]);
+    }
+    vertex_id_index_.reserve(vertex_num);
+    for (size_t i = 0; i < vertex_num; i++) {
+      vertex_id_index_.emplace_back(vertices_.data() + vertex_id_order[i]);
+    }
+
+    edges_.reserve(edge_num);
+    for (size_t i = 0; i < edge_num; i++) {
+      edges_.emplace_back(edge_id[i], edge_label[i],
+                          vertices_.data() + edge_src[i],
+                          vertices_.data() + edge_dst[i]);
+    }
+    edge_id_index_.reserve(edge_num);
+    out_edges_.reserve(edge_num);
+     in_edges_.reserve(edge_num);
+    for (size_t i = 0; i < edge_num; i++) {
+      edge_id_index_.emplace_back(edges_.data() + edge_id_order[i]);
+      out_edges_.emplace_back(edges_.data() + i);
+       in_edges_.emplace_back(edges_.data() + in_edge[i]);
+    }
+    assert(std::is_sorted(out_edges_.begin(), out_edges_.end(),
+                          EdgeLess<true>));
+    assert(std::is_sorted( in_edges_.begin(),  in_edges_.end(),
+                          EdgeLess<false>));
+
+    this->template BuildDirection<true >(out_edges_, out_groups_, out_vertices_);
+    this->template BuildDirection<false>( in_edges_,  in_groups_,  in_vertices_);
+    return;
+  }
+
+  void Clear() {
+    out_vertices_.clear();
+     in_vertices_.clear();
+    out_groups_.clear();
+     in_groups_.clear();
+    out_edges_.clear();
+     in_edges_.clear();
+    edge_id_index_.clear();
+    edges_.clear();
+    vertex_id_index_.clear();
+    vertices_.clear();
+  }
+
+ private:
+  std::pair<const VertexData *, const VertexData *> LabelRange(
+      const VertexLabelType &label) const {
+    struct LabelCompare {
+      bool operator()(const VertexData &v, const VertexLabelType &l) const {
+        return v.label_ < l;
+      }
+      bool operator()(const VertexLabelType &l, const VertexData &v) const {
+        return l < v.label_;
+      }
+    };
+    const VertexData *begin = vertices_.data(),
+                     *  end = vertices_.data() + vertices_.size();
+    return std::equal_range(begin, end, label, LabelCompare());
+  }
+
+  template <typename GraphType>
+  void BuildFrom(const GraphType &other) {
+    using OtherVertexHandle = typename VertexHandle<const GraphType>::type;
+    using OtherEdgeHandle   = typename   EdgeHandle<const GraphType>::type;
+
+    std::vector<VertexRecord> vertex_records;
+    std::vector<  EdgeRecord>   edge_records;
+    std::vector<OtherVertexHandle> other_vertex_handles;
+    std::vector<OtherEdgeHandle>   other_edge_handles;
+    for (auto vertex_it = other.VertexBegin();
+             !vertex_it.IsDone();
+              vertex_it++) {
+      OtherVertexHandle vertex_handle = vertex_it;
+      vertex_records.emplace_back(vertex_handle->id(),
+                                  vertex_handle->label());
+      other_vertex_handles.emplace_back(vertex_handle);
+      for (auto edge_it = vertex_handle->OutEdgeBegin();
+               !edge_it.IsDone();
+                edge_it++) {
+        OtherEdgeHandle edge_handle = edge_it;
+        edge_records.emplace_back(edge_handle->id(),
+                                  edge_handle->src_handle()->id(),
+                                  edge_handle->dst_handle()->id(),
+                                  edge_handle->label());
+        other_edge_handles.emplace_back(edge_handle);
+      }
+    }
+    this->Build(std::move(vertex_records),
+                std::move(  edge_records));
+
+    if constexpr (GraphParameter<GraphType>::vertex_has_attribute) {
+      for (auto &other_vertex_handle : other_vertex_handles) {
+        VertexPtr vertex_ptr = this->FindVertex(other_vertex_handle->id());
+        assert(vertex_ptr);
+        CopyAllAttributes(other_vertex_handle, vertex_ptr);
+      }
+    }
+    if constexpr (GraphParameter<GraphType>::edge_has_attribute) {
+      for (auto &other_edge_handle : other_edge_handles) {
+        EdgePtr edge_ptr = this->FindEdge(other_edge_handle->id());
+        assert(edge_ptr);
+        CopyAllAttributes(other_edge_handle, edge_ptr);
+      }
+    }
+    return;
+  }
+
+  template <bool is_out>
+  static inline VertexData *Adjacent(const EdgeData *e) {
+    return is_out ? e->dst_ : e->src_;
+  }
+
+  // edge_ptrs have already been sorted by
+  //   (vertex, edge label, adjacent vertex label, adjacent vertex, edge id)
+  // build the label groups and distinct adjacent vertexes
+  // for all vertexes in one direction
+  template <bool is_out>
+  void BuildDirection(std::vector<EdgeData *> &edge_ptrs,
+                      std::vector<LabelGroup> &groups,
+                      std::vector<VertexData *> &adj_vertices) {
+    auto vertex_of = [](const EdgeData *e) {
+      return is_out ? e->src_ : e->dst_;
+    };
+
+    // count the number of groups and distinct adjacent vertexes
+    // in advance to make sure the arrays would not be reallocated
+    size_t group_count = 0,
+           adj_vertex_count = 0;
+    for (size_t i = 0; i < edge_ptrs.size(); i++) {
+      if (i == 0
+       || vertex_of(edge_ptrs[i]) != vertex_of(edge_ptrs[i - 1])
+       || edge_ptrs[i]->label_    != edge_ptrs[i - 1]->label_) {
+        group_count++;
+        adj_vertex_count++;
+        continue;
+      }
+      if (Adjacent<is_out>(edge_ptrs[i])
+       != Adjacent<is_out>(edge_ptrs[i - 1])) {
+        adj_vertex_count++;
+      }
+    }
+    groups.clear();
+    groups.reserve(group_count);
+    adj_vertices.clear();
+    adj_vertices.reserve(adj_vertex_count);
+
+    std::vector<VertexData *> vertex_adjacent;
+    size_t edge_idx = 0;
+    for (auto &vertex : vertices_) {
+      EdgeData **edge_begin = edge_ptrs.data() + edge_idx;
+      LabelGroup *group_begin = groups.data() + groups.size();
+      vertex_adjacent.clear();
+      while (edge_idx < edge_ptrs.size()
+          && vertex_of(edge_ptrs[edge_idx]) == &vertex) {
+        LabelGroup group;
+        group.label_ = edge_ptrs[edge_idx]->label_;
+        group.edge_begin_   = edge_ptrs.data() + edge_idx;
+        group.vertex_begin_ = adj_vertices.data() + adj_vertices.size();
+        while (edge_idx < edge_ptrs.size()
+            && vertex_of(edge_ptrs[edge_idx]) == &vertex
+            && edge_ptrs[edge_idx]->label_ == group.label_) {
+          VertexData *adj = Adjacent<is_out>(edge_ptrs[edge_idx]);
+          if (adj_vertices.data() + adj_vertices.size()
+                == group.vertex_begin_
+           || adj_vertices.back() != adj) {
+            adj_vertices.emplace_back(adj);
+            vertex_adjacent.emplace_back(adj);
+          }
+          edge_idx++;
+        }
+        group.edge_end_   = edge_ptrs.data() + edge_idx;
+        group.vertex_end_ = adj_vertices.data() + adj_vertices.size();
+        groups.emplace_back(group);
+      }
+      EdgeData **edge_end = edge_ptrs.data() + edge_idx;
+      LabelGroup *group_end = groups.data() + groups.size();
+
+      std::sort(vertex_adjacent.begin(), vertex_adjacent.end());
+      size_t vertex_count = std::unique(vertex_adjacent.begin(),
+                                        vertex_adjacent.end())
+                          - vertex_adjacent.begin();
+      if constexpr (is_out) {
+        vertex.out_edge_begin_   = edge_begin;
+        vertex.out_edge_end_     = edge_end;
+        vertex.out_group_begin_  = group_begin;
+        vertex.out_group_end_    = group_end;
+        vertex.out_vertex_count_ = vertex_count;
+      } else {
+        vertex.in_edge_begin_    = edge_begin;
+        vertex.in_edge_end_      = edge_end;
+        vertex.in_group_begin_   = group_begin;
+        vertex.in_group_end_     = group_end;
+        vertex.in_vertex_count_  = vertex_count;
+      }
+    }
+    assert(edge_idx == edge_ptrs.size());
+    assert(groups.size() == group_count);
+    assert(adj_vertices.size() == adj_vertex_count);
+    return;
+  }
+
+  template <bool is_out>
+  static inline bool EdgeLess(const EdgeData *a, const EdgeData *b) {
+    const VertexData *a_vertex = is_out ? a->src_ : a->dst_,
+                     *b_vertex = is_out ? b->src_ : b->dst_;
+    if (a_vertex != b_vertex) {
+      return std::less<const VertexData *>()(a_vertex, b_vertex);
+    }
+    if (a->label_ != b->label_) {
+      return a->label_ < b->label_;
+    }
+    const VertexData *a_adj = Adjacent<is_out>(a),
+                     *b_adj = Adjacent<is_out>(b);
+    if (a_adj->label_ != b_adj->label_) {
+      return a_adj->label_ < b_adj->label_;
+    }
+    if (a_adj != b_adj) {
+      return std::less<const VertexData *>()(a_adj, b_adj);
+    }
+    return a->id_ < b->id_;
+  }
+
+  void Build(std::vector<VertexRecord> vertex_records,
+             std::vector<  EdgeRecord>   edge_records) {
+    this->Clear();
+
+    // remove the vertexes with duplicated id, keep the first one
+    std::stable_sort(vertex_records.begin(), vertex_records.end(),
+                     [](const VertexRecord &a, const VertexRecord &b) {
+                       return a.first < b.first;
+                     });
+    vertex_records.erase(
+        std::unique(vertex_records.begin(), vertex_records.end(),
+                    [](const VertexRecord &a, const VertexRecord &b) {
+                      return a.first == b.first;
+                    }),
+        vertex_records.end());
+    std::sort(vertex_records.begin(), vertex_records.end(),
+              [](const VertexRecord &a, const VertexRecord &b) {
+                if (a.second != b.second) {
+                  return a.second < b.second;
+                }
+                return a.first < b.first;
+              });
+
+    vertices_.reserve(vertex_records.size());
+    for (const auto &[id, label] : vertex_records) {
+      vertices_.emplace_back(id, label);
+    }
+    assert(vertices_.size() == vertex_records.size());
+    std::vector<VertexRecord>().swap(vertex_records);
+
+    vertex_id_index_.reserve(vertices_.size());
+    for (auto &vertex : vertices_) {
+      vertex_id_index_.emplace_back(&vertex);
+    }
+    std::sort(vertex_id_index_.begin(), vertex_id_index_.end(),
+              [](const VertexData *a, const VertexData *b) {
+                return a->id_ < b->id_;
+              });
+
+    // remove the edges with duplicated id, keep the first one
+    std::stable_sort(edge_records.begin(), edge_records.end(),
+                     [](const EdgeRecord &a, const EdgeRecord &b) {
+                       return std::get<0>(a) < std::get<0>(b);
+                     });
+    edge_records.erase(
+        std::unique(edge_records.begin(), edge_records.end(),
+                    [](const EdgeRecord &a, const EdgeRecord &b) {
+                      return std::get<0>(a) == std::get<0>(b);
+                    }),
+        edge_records.end());
+
+    // remove the edges with not existing src/dst vertex
+    std::vector<std::tuple<VertexData *, VertexData *, size_t>> edge_order;
+    edge_order.reserve(edge_records.size());
+    for (size_t i = 0; i < edge_records.size(); i++) {
+      VertexPtr src_ptr = this->FindVertex(std::get<1>(edge_records[i])),
+                dst_ptr = this->FindVertex(std::get<2>(edge_records[i]));
+      if (!src_ptr || !dst_ptr) {
+        continue;
+      }
+      edge_order.emplace_back(src_ptr, dst_ptr, i);
+    }
+    std::sort(edge_order.begin(), edge_order.end(),
+              [&edge_records](const auto &a, const auto &b) {
+                const auto &[a_src, a_dst, a_idx] = a;
+                const auto &[b_src, b_dst, b_idx] = b;
+                if (a_src != b_src) {
+                  return std::less<const VertexData *>()(a_src, b_src);
+                }
+                const auto &a_label = std::get<3>(edge_records[a_idx]),
+                           &b_label = std::get<3>(edge_records[b_idx]);
+                if (a_label != b_label) {
+                  return a_label < b_label;
+                }
+                if (a_dst->label_ != b_dst->label_) {
+                  return a_dst->label_ < b_dst->label_;
+                }
+                if (a_dst != b_dst) {
+                  return std::less<const VertexData *>()(a_dst, b_dst);
+                }
+                return std::get<0>(edge_records[a_idx])
+                     < std::get<0>(edge_records[b_idx]);
+              });
+
+    // the edges are held in the order of the out edges
+    edges_.reserve(edge_order.size());
+    for (const auto &[src_ptr, dst_ptr, idx] : edge_order) {
+      edges_.emplace_back(std::get<0>(edge_records[idx]),
+                          std::get<3>(edge_records[idx]),
+                          src_ptr, dst_ptr);
+    }
+    assert(edges_.size() == edge_order.size());
+    decltype(edge_order)().swap(edge_order);
+    std::vector<EdgeRecord>().swap(edge_records);
+
+    edge_id_index_.reserve(edges_.size());
+    out_edges_.reserve(edges_.size());
+     in_edges_.reserve(edges_.size());
+    for (auto &edge : edges_) {
+      edge_id_index_.emplace_back(&edge);
+      out_edges_.emplace_back(&edge);
+       in_edges_.emplace_back(&edge);
+    }
+    std::sort(edge_id_index_.begin(), edge_id_index_.end(),
+              [](const EdgeData *a, const EdgeData *b) {
+                return a->id_ < b->id_;
+              });
+    assert(std::is_sorted(out_edges_.begin(), out_edges_.end(),
+                          EdgeLess<true>));
+    std::sort(in_edges_.begin(), in_edges_.end(), EdgeLess<false>);
+
+    this->template BuildDirection<true >(out_edges_, out_groups_, out_vertices_);
+    this->template BuildDirection<false>( in_edges_,  in_groups_,  in_vertices_);
+    return;
+  }
+
+  // sorted by (label, id)
+  std::vector<VertexData> vertices_;
+
+  // sorted by id
+  std::vector<VertexData *> vertex_id_index_;
+
+  // sorted by (src, edge label, dst label, dst, id)
+  std::vector<EdgeData> edges_;
+
+  // sorted by id
+  std::vector<EdgeData *> edge_id_index_;
+
+  // sorted by (src, edge label, dst label, dst, id)
+  std::vector<EdgeData *> out_edges_;
+  // sorted by (dst, edge label, src label, src, id)
+  std::vector<EdgeData *>  in_edges_;
+
+  std::vector<LabelGroup> out_groups_,
+                           in_groups_;
+
+  std::vector<VertexData *> out_vertices_,
+                             in_vertices_;
+};
+
+}  // namespace GUNDAM
+
+#endif  // _GUNDAM_GRAPH_TYPE_CSR_GRAPH_H
@@ -1,6 +1,7 @@
 #ifndef _GUNDAM_GRAPH_TYPE_LARGE_GRAPH_H
 #define _GUNDAM_GRAPH_TYPE_LARGE_GRAPH_H
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <unordered_set>
@@ -403,6 +404,51 @@ class LargeGraph {
       // this->adj_vertex_.insert(src);
     }
 
+    // links the out edges sorted by (label, dst) together, each index
+    // is accessed once for each group of edges sharing its key
+    void AddOutEdgeBatch(typename std::vector<EdgeData *>::const_iterator begin,
+                         typename std::vector<EdgeData *>::const_iterator end) {
+      for (auto it = begin; it != end;) {
+        const auto &edge_label = (*it)->label();
+        auto &label_edges = out_edge_labels_[edge_label];
+        auto &label_vertices = out_vertices_[edge_label];
+        for (; it != end && (*it)->label() == edge_label; ++it) {
+          EdgeData *e = *it;
+          assert(e->src_handle() == this);
+          auto ret1 = out_edges_.insert(e);
+          assert(ret1.second);
+          auto ret2 = label_edges.insert(e);
+          assert(ret2.second);
+          label_vertices.emplace_hint(label_vertices.end(), e->dst_handle());
+          auto ret4 =
+              out_edge_build_on_vertex_[e->dst_handle()][edge_label].insert(e);
+          assert(ret4.second);
+        }
+      }
+    }
+
+    // links the in edges sorted by (label, src) together
+    void AddInEdgeBatch(typename std::vector<EdgeData *>::const_iterator begin,
+                        typename std::vector<EdgeData *>::const_iterator end) {
+      for (auto it = begin; it != end;) {
+        const auto &edge_label = (*it)->label();
+        auto &label_edges = in_edge_labels_[edge_label];
+        auto &label_vertices = in_vertices_[edge_label];
+        for (; it != end && (*it)->label() == edge_label; ++it) {
+          EdgeData *e = *it;
+          assert(e->dst_handle() == this);
+          auto ret1 = in_edges_.insert(e);
+          assert(ret1.second);
+          auto ret2 = label_edges.insert(e);
+          assert(ret2.second);
+          label_vertices.emplace_hint(label_vertices.end(), e->src_handle());
+          auto ret4 =
+              in_edge_build_on_vertex_[e->src_handle()][edge_label].insert(e);
+          assert(ret4.second);
+        }
+      }
+    }
+
     void RemoveOutEdge(EdgeData *e) {
       assert(e->src_handle() == this);
 
@@ -672,6 +718,41 @@ class LargeGraph {
     return std::make_pair(v, true);
   }
 
+  // adds the (id, label) pairs as calling AddVertex on them one by one,
+  // the results are in the same order as the pairs
+  std::vector<std::pair<VertexPtr, bool>> AddVertexBatch(
+      const std::vector<std::pair<typename VertexType::IDType,
+                                  typename VertexType::LabelType>> &vertexes) {
+    std::vector<std::pair<VertexIDType, VertexData *>> batch;
+    batch.reserve(vertexes.size());
+    for (const auto &[id, label] : vertexes) {
+      batch.emplace_back(id, new VertexData(id, label));
+    }
+    std::vector<bool> inserted;
+    vertices_.InsertBatch(batch, inserted);
+
+    std::vector<std::pair<VertexPtr, bool>> ret;
+    ret.reserve(vertexes.size());
+    std::map<VertexLabelType,
+             std::vector<std::pair<VertexIDType, VertexData *>>> label_batches;
+    for (size_t idx = 0; idx < vertexes.size(); idx++) {
+      const auto &[id, label] = vertexes[idx];
+      VertexData *v = batch[idx].second;
+      if (!inserted[idx]) {
+        delete v;
+        ret.emplace_back(vertices_.Find(id)->second, false);
+        continue;
+      }
+      label_batches[label].emplace_back(id, v);
+      ret.emplace_back(v, true);
+    }
+    for (auto &[label, label_batch] : label_batches) {
+      std::vector<bool> label_inserted;
+      vertex_labels_[label].InsertBatch(label_batch, label_inserted);
+    }
+    return ret;
+  }
+
   VertexPtr FindVertex(const typename VertexType::IDType &id) {
     auto it = vertices_.Find(id);
     if (it == vertices_.end()) return nullptr;
@@ -713,6 +794,8 @@ class LargeGraph {
     auto it_v = vertices_.Find(id);
     if (it_v == vertices_.end()) return 0;
 
+    LinkBulkEdges();
+
     size_t count = 0;
 
     VertexData *v = it_v->second;
@@ -761,12 +844,77 @@ class LargeGraph {
     if (!ret1.second) {
       return std::make_pair(ret1.first->second, false);
     }
+    if (bulk_loading_) {
+      bulk_edges_.emplace_back(e);
+      return std::make_pair(e, true);
+    }
     src_ptr->AddOutEdge(e);
     dst_ptr->AddInEdge(e);
 
     return std::make_pair(e, true);
   }
 
+  // adds the (src, dst, label, id) tuples as calling AddEdge on them one
+  // by one, the results are in the same order as the tuples
+  std::vector<std::pair<EdgePtr, bool>> AddEdgeBatch(
+      const std::vector<std::tuple<typename VertexType::IDType,
+                                   typename VertexType::IDType,
+                                   typename EdgeType::LabelType,
+                                   typename EdgeType::IDType>> &edges) {
+    std::vector<std::pair<EdgePtr, bool>> ret(
+        edges.size(), std::pair<EdgePtr, bool>(nullptr, false));
+    std::vector<std::pair<EdgeIDType, EdgeData *>> batch;
+    std::vector<size_t> batch_idx;
+    batch.reserve(edges.size());
+    batch_idx.reserve(edges.size());
+    for (size_t idx = 0; idx < edges.size(); idx++) {
+      const auto &[src, dst, label, id] = edges[idx];
+      VertexData *src_ptr = FindVertex(src);
+      VertexData *dst_ptr = FindVertex(dst);
+      if (!src_ptr || !dst_ptr) {
+        continue;
+      }
+      batch.emplace_back(id, new EdgeData(id, label, src_ptr, dst_ptr));
+      batch_idx.emplace_back(idx);
+    }
+    std::vector<bool> inserted;
+    edges_.InsertBatch(batch, inserted);
+
+    for (size_t i = 0; i < batch_idx.size(); i++) {
+      const auto &id = std::get<3>(edges[batch_idx[i]]);
+      EdgeData *e = batch[i].second;
+      if (!inserted[i]) {
+        delete e;
+        ret[batch_idx[i]] = std::make_pair(edges_.Find(id)->second, false);
+        continue;
+      }
+      if (bulk_loading_) {
+        bulk_edges_.emplace_back(e);
+      } else {
+        e->src_handle()->AddOutEdge(e);
+        e->dst_handle()->AddInEdge(e);
+      }
+      ret[batch_idx[i]] = std::make_pair(e, true);
+    }
+    return ret;
+  }
+
+  // starts a bulk load, the edges added by AddEdge and AddEdgeBatch are
+  // then only indexed by id, they are linked into the adjacency of their
+  // vertexes all together at EndBulkLoad, the adjacency of the vertexes
+  // does not contain them before that
+  void BeginBulkLoad() { bulk_loading_ = true; }
+
+  bool IsBulkLoading() const { return bulk_loading_; }
+
+  // links the edges added since BeginBulkLoad, the edges are sorted once
+  // by source and once by destination, the vertexes are then linked
+  // in parallel
+  void EndBulkLoad() {
+    LinkBulkEdges();
+    bulk_loading_ = false;
+  }
+
   EdgePtr FindEdge(const typename EdgeType::IDType &id) {
     auto it = edges_.Find(id);
     if (it == edges_.end()) return nullptr;
@@ -791,6 +939,8 @@ class LargeGraph {
     auto it = edges_.Find(id);
     if (it == edges_.end()) return 0;
 
+    LinkBulkEdges();
+
     EdgeData *e = it->second;
     e->src_handle()->RemoveOutEdge(e);
     e->dst_handle()->RemoveInEdge(e);
@@ -811,14 +961,74 @@ class LargeGraph {
     vertices_.Clear();
     edges_.Clear();
     vertex_labels_.clear();
+    bulk_edges_.clear();
   }
 
  private:
+  template <bool is_out>
+  static bool CompareBulkEdge(const EdgeData *e0, const EdgeData *e1) {
+    const VertexData *v0 = is_out ? e0->const_src_handle()
+                                  : e0->const_dst_handle();
+    const VertexData *v1 = is_out ? e1->const_src_handle()
+                                  : e1->const_dst_handle();
+    if (v0 != v1) return std::less<const VertexData *>()(v0, v1);
+    if (e0->label() != e1->label()) return e0->label() < e1->label();
+    const VertexData *u0 = is_out ? e0->const_dst_handle()
+                                  : e0->const_src_handle();
+    const VertexData *u1 = is_out ? e1->const_dst_handle()
+                                  : e1->const_src_handle();
+    return std::less<const VertexData *>()(u0, u1);
+  }
+
+  // the sorted edges are split into the groups of the same vertex,
+  // each group is linked by one thread
+  template <bool is_out>
+  static void LinkSortedBulkEdges(const std::vector<EdgeData *> &edges) {
+    std::vector<size_t> group_begin;
+    for (size_t idx = 0; idx < edges.size(); idx++) {
+      if (idx == 0 || (is_out ? edges[idx]->src_handle()
+                                  != edges[idx - 1]->src_handle()
+                              : edges[idx]->dst_handle()
+                                  != edges[idx - 1]->dst_handle())) {
+        group_begin.emplace_back(idx);
+      }
+    }
+    group_begin.emplace_back(edges.size());
+    const long long kGroupNum = group_begin.size() - 1;
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long group = 0; group < kGroupNum; group++) {
+      auto begin = edges.cbegin() + group_begin[group];
+      auto end   = edges.cbegin() + group_begin[group + 1];
+      if constexpr (is_out) {
+        (*begin)->src_handle()->AddOutEdgeBatch(begin, end);
+      } else {
+        (*begin)->dst_handle()->AddInEdgeBatch(begin, end);
+      }
+    }
+  }
+
+  void LinkBulkEdges() {
+    if (bulk_edges_.empty()) return;
+    std::vector<EdgeData *> in_edges(bulk_edges_);
+    std::sort(bulk_edges_.begin(), bulk_edges_.end(),
+              CompareBulkEdge<true>);
+    LinkSortedBulkEdges<true>(bulk_edges_);
+    std::sort(in_edges.begin(), in_edges.end(), CompareBulkEdge<false>);
+    LinkSortedBulkEdges<false>(in_edges);
+    bulk_edges_.clear();
+    bulk_edges_.shrink_to_fit();
+  }
+
   VertexContainer vertices_;
 
   std::map<VertexLabelType, VertexContainer> vertex_labels_;
 
   EdgeContainer edges_;
+
+  bool bulk_loading_ = false;
+
+  // the edges added during the bulk load that are not linked yet
+  std::vector<EdgeData *> bulk_edges_;
 };
 
 // class SmallGraph {
@@ -1,6 +1,9 @@
 #ifndef _GUNDAM_GRAPH_TYPE_LARGE_GRAPH2_H
 #define _GUNDAM_GRAPH_TYPE_LARGE_GRAPH2_H
 
+#include <algorithm>
+#include <vector>
+
 #include "gundam/component/attribute.h"
 #include "gundam/component/container2.h"
 #include "gundam/component/iterator2.h"
@@ -393,6 +396,86 @@ class LargeGraph2 {
       assert(ret9.second);
     }
 
+    // links the out edges together, the indexes are rebuilt from these
+    // edges and the ones already linked
+    void AddOutEdgeBatch(std::vector<EdgeData *> &edges) {
+      edges.insert(edges.end(), out_edges_.begin(), out_edges_.end());
+      out_edges_.Clear();
+      out_edges_by_el_.Clear();
+      out_edges_by_dst_el_.Clear();
+      out_edges_by_el_dst_.Clear();
+      BuildEdgeIndexes<true>(edges, out_edges_, out_edges_by_el_,
+                             out_edges_by_dst_el_, out_edges_by_el_dst_);
+    }
+
+    // links the in edges together, the indexes are rebuilt from these
+    // edges and the ones already linked
+    void AddInEdgeBatch(std::vector<EdgeData *> &edges) {
+      edges.insert(edges.end(), in_edges_.begin(), in_edges_.end());
+      in_edges_.Clear();
+      in_edges_by_el_.Clear();
+      in_edges_by_src_el_.Clear();
+      in_edges_by_el_src_.Clear();
+      BuildEdgeIndexes<false>(edges, in_edges_, in_edges_by_el_,
+                              in_edges_by_src_el_, in_edges_by_el_src_);
+    }
+
+    // the edges are sorted into the key order of each index in turn, so
+    // that every insertion appends to the end of the sorted vectors
+    // instead of shifting them
+    template <bool is_out>
+    static void BuildEdgeIndexes(std::vector<EdgeData *> &edges,
+                                 EdgePtrSet &edge_set,
+                                 EdgeIndexByELabel &by_el,
+                                 EdgeIndexByVertexELabel &by_vertex_el,
+                                 EdgeIndexByELabelVertex &by_el_vertex) {
+      auto adj = [](EdgeData *e) {
+        if constexpr (is_out) {
+          return e->dst_handle();
+        } else {
+          return e->src_handle();
+        }
+      };
+
+      std::sort(edges.begin(), edges.end());
+      for (const auto &e : edges) {
+        auto ret = edge_set.Insert(e);
+        assert(ret.second);
+      }
+
+      std::sort(edges.begin(), edges.end(), [](EdgeData *e0, EdgeData *e1) {
+        if (e0->label() != e1->label()) return e0->label() < e1->label();
+        return e0 < e1;
+      });
+      for (const auto &e : edges) {
+        by_el.Insert(e->label()).first->second.Insert(e);
+      }
+
+      std::sort(edges.begin(), edges.end(),
+                [&adj](EdgeData *e0, EdgeData *e1) {
+                  if (e0->label() != e1->label())
+                    return e0->label() < e1->label();
+                  if (adj(e0) != adj(e1)) return adj(e0) < adj(e1);
+                  return e0 < e1;
+                });
+      for (const auto &e : edges) {
+        by_el_vertex.Insert(e->label()).first->second
+                    .Insert(adj(e)).first->second.Insert(e);
+      }
+
+      std::sort(edges.begin(), edges.end(),
+                [&adj](EdgeData *e0, EdgeData *e1) {
+                  if (adj(e0) != adj(e1)) return adj(e0) < adj(e1);
+                  if (e0->label() != e1->label())
+                    return e0->label() < e1->label();
+                  return e0 < e1;
+                });
+      for (const auto &e : edges) {
+        by_vertex_el.Insert(adj(e)).first->second
+                    .Insert(e->label()).first->second.Insert(e);
+      }
+    }
+
     void RemoveOutEdge(EdgeData *e) {
       assert(e->src_handle() == this);
 
@@ -658,6 +741,42 @@ class LargeGraph2 {
     return std::make_pair(v, true);
   }
 
+  // adds the (id, label) pairs as calling AddVertex on them one by one,
+  // the results are in the same order as the pairs
+  std::vector<std::pair<VertexPtr, bool>> AddVertexBatch(
+      const std::vector<std::pair<typename VertexType::IDType,
+                                  typename VertexType::LabelType>> &vertexes) {
+    std::vector<std::pair<VertexIDType, VertexData *>> batch;
+    batch.reserve(vertexes.size());
+    for (const auto &[id, label] : vertexes) {
+      batch.emplace_back(id, new VertexData(id, label));
+    }
+    std::vector<bool> inserted;
+    vertices_.InsertBatch(batch, inserted);
+
+    std::vector<std::pair<VertexPtr, bool>> ret;
+    ret.reserve(vertexes.size());
+    std::map<VertexLabelType,
+             std::vector<std::pair<VertexIDType, VertexData *>>> label_batches;
+    for (size_t idx = 0; idx < vertexes.size(); idx++) {
+      const auto &[id, label] = vertexes[idx];
+      VertexData *v = batch[idx].second;
+      if (!inserted[idx]) {
+        delete v;
+        ret.emplace_back(vertices_.Find(id)->second, false);
+        continue;
+      }
+      label_batches[label].emplace_back(id, v);
+      ret.emplace_back(v, true);
+    }
+    for (auto &[label, label_batch] : label_batches) {
+      std::vector<bool> label_inserted;
+      vertex_labels_.Insert(label).first->second.InsertBatch(
+          label_batch, label_inserted);
+    }
+    return ret;
+  }
+
   VertexPtr FindVertex(const typename VertexType::IDType &id) {
     auto it = vertices_.Find(id);
     if (it == vertices_.end()) return nullptr;
@@ -699,6 +818,8 @@ class LargeGraph2 {
     auto it_v = vertices_.Find(id);
     if (it_v == vertices_.end()) return 0;
 
+    LinkBulkEdges();
+
     size_t count = 0;
 
     VertexData *v = it_v->second;
@@ -744,12 +865,77 @@ class LargeGraph2 {
     if (!ret1.second) {
       return std::make_pair(ret1.first->second, false);
     }
+    if (bulk_loading_) {
+      bulk_edges_.emplace_back(e);
+      return std::make_pair(e, true);
+    }
     src_ptr->AddOutEdge(e);
     dst_ptr->AddInEdge(e);
 
     return std::make_pair(e, true);
   }
 
+  // adds the (src, dst, label, id) tuples as calling AddEdge on them one
+  // by one, the results are in the same order as the tuples
+  std::vector<std::pair<EdgePtr, bool>> AddEdgeBatch(
+      const std::vector<std::tuple<typename VertexType::IDType,
+                                   typename VertexType::IDType,
+                                   typename EdgeType::LabelType,
+                                   typename EdgeType::IDType>> &edges) {
+    std::vector<std::pair<EdgePtr, bool>> ret(
+        edges.size(), std::pair<EdgePtr, bool>(nullptr, false));
+    std::vector<std::pair<EdgeIDType, EdgeData *>> batch;
+    std::vector<size_t> batch_idx;
+    batch.reserve(edges.size());
+    batch_idx.reserve(edges.size());
+    for (size_t idx = 0; idx < edges.size(); idx++) {
+      const auto &[src, dst, label, id] = edges[idx];
+      VertexData *src_ptr = FindVertex(src);
+      VertexData *dst_ptr = FindVertex(dst);
+      if (!src_ptr || !dst_ptr) {
+        continue;
+      }
+      batch.emplace_back(id, new EdgeData(id, label, src_ptr, dst_ptr));
+      batch_idx.emplace_back(idx);
+    }
+    std::vector<bool> inserted;
+    edges_.InsertBatch(batch, inserted);
+
+    for (size_t i = 0; i < batch_idx.size(); i++) {
+      const auto &id = std::get<3>(edges[batch_idx[i]]);
+      EdgeData *e = batch[i].second;
+      if (!inserted[i]) {
+        delete e;
+        ret[batch_idx[i]] = std::make_pair(edges_.Find(id)->second, false);
+        continue;
+      }
+      if (bulk_loading_) {
+        bulk_edges_.emplace_back(e);
+      } else {
+        e->src_handle()->AddOutEdge(e);
+        e->dst_handle()->AddInEdge(e);
+      }
+      ret[batch_idx[i]] = std::make_pair(e, true);
+    }
+    return ret;
+  }
+
+  // starts a bulk load, the edges added by AddEdge and AddEdgeBatch are
+  // then only indexed by id, they are linked into the adjacency of their
+  // vertexes all together at EndBulkLoad, the adjacency of the vertexes
+  // does not contain them before that
+  void BeginBulkLoad() { bulk_loading_ = true; }
+
+  bool IsBulkLoading() const { return bulk_loading_; }
+
+  // links the edges added since BeginBulkLoad, each index of a vertex
+  // is built with one sort of its edges instead of one shifting insertion
+  // for each edge, the vertexes are linked in parallel
+  void EndBulkLoad() {
+    LinkBulkEdges();
+    bulk_loading_ = false;
+  }
+
   EdgePtr FindEdge(const typename EdgeType::IDType &id) {
     auto it = edges_.Find(id);
     if (it == edges_.end()) return nullptr;
@@ -774,6 +960,8 @@ class LargeGraph2 {
     auto it = edges_.Find(id);
     if (it == edges_.end()) return 0;
 
+    LinkBulkEdges();
+
     EdgeData *e = it->second;
     e->src_handle()->RemoveOutEdge(e);
     e->dst_handle()->RemoveInEdge(e);
@@ -794,14 +982,69 @@ class LargeGraph2 {
     vertices_.Clear();
     vertex_labels_.Clear();
     edges_.Clear();
+    bulk_edges_.clear();
   }
 
  private:
+  // the edges sorted by source or destination are split into the groups
+  // of the same vertex, each group is linked by one thread
+  template <bool is_out>
+  static void LinkSortedBulkEdges(const std::vector<EdgeData *> &edges) {
+    auto vertex = [](EdgeData *e) {
+      if constexpr (is_out) {
+        return e->src_handle();
+      } else {
+        return e->dst_handle();
+      }
+    };
+    std::vector<size_t> group_begin;
+    for (size_t idx = 0; idx < edges.size(); idx++) {
+      if (idx == 0 || vertex(edges[idx]) != vertex(edges[idx - 1])) {
+        group_begin.emplace_back(idx);
+      }
+    }
+    group_begin.emplace_back(edges.size());
+    const long long kGroupNum = group_begin.size() - 1;
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long group = 0; group < kGroupNum; group++) {
+      std::vector<EdgeData *> group_edges(
+          edges.cbegin() + group_begin[group],
+          edges.cbegin() + group_begin[group + 1]);
+      if constexpr (is_out) {
+        vertex(group_edges.front())->AddOutEdgeBatch(group_edges);
+      } else {
+        vertex(group_edges.front())->AddInEdgeBatch(group_edges);
+      }
+    }
+  }
+
+  void LinkBulkEdges() {
+    if (bulk_edges_.empty()) return;
+    std::vector<EdgeData *> in_edges(bulk_edges_);
+    std::sort(bulk_edges_.begin(), bulk_edges_.end(),
+              [](EdgeData *e0, EdgeData *e1) {
+                return e0->src_handle() < e1->src_handle();
+              });
+    LinkSortedBulkEdges<true>(bulk_edges_);
+    std::sort(in_edges.begin(), in_edges.end(),
+              [](EdgeData *e0, EdgeData *e1) {
+                return e0->dst_handle() < e1->dst_handle();
+              });
+    LinkSortedBulkEdges<false>(in_edges);
+    bulk_edges_.clear();
+    bulk_edges_.shrink_to_fit();
+  }
+
   VertexIndexByID vertices_;
 
   VertexIndexByLabel vertex_labels_;
 
   EdgeIndexByID edges_;
+
+  bool bulk_loading_ = false;
+
+  // the edges added during the bulk load that are not linked yet
+  std::vector<EdgeData *> bulk_edges_;
 };
 
 }  // namespace GUNDAM
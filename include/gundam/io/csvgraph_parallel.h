@@ -0,0 +1,710 @@
+#ifndef _GUNDAM_IO_CSVGRAPH_PARALLEL_H
+#define _GUNDAM_IO_CSVGRAPH_PARALLEL_H
+
+#include <omp.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "gundam/data_type/datatype.h"
+#include "gundam/data_type/datetime.h"
+#include "gundam/io/csvgraph.h"
+#include "gundam/type_getter/edge_handle.h"
+#include "gundam/type_getter/graph_parameter_getter.h"
+#include "gundam/type_getter/vertex_handle.h"
+
+// loads the same csv files as ReadCSVGraph, the file is read in chunks
+// of complete lines, each chunk is split into byte ranges that are
+// tokenized and converted on multiple threads, then the rows of each
+// chunk are added to the graph in one batch through AddVertexBatch and
+// AddEdgeBatch if the graph supports them, in the order of the file,
+// the edges are linked into the adjacency at the end of each edge file
+// if the graph supports BeginBulkLoad/EndBulkLoad
+//
+// only the current chunk is held in memory instead of the whole
+// document, the fields can be quoted with '"' but should not contain
+// line breaks
+
+namespace GUNDAM {
+
+namespace _csv_parallel {
+
+constexpr size_t kDefaultChunkSize = (size_t)64 << 20;
+
+constexpr char kSeparator = ',';
+
+constexpr char kQuote = '"';
+
+// null for the empty cells
+using CellValue = std::variant<std::monostate,
+                               std::string,
+                               int,
+                               int64_t,
+                               float,
+                               double,
+                               DateTime>;
+
+// split one line into fields, the quotes are removed in place
+inline void SplitLine(char* begin, char* end,
+                      std::vector<std::string_view>& fields) {
+  fields.clear();
+  if (end > begin && *(end - 1) == '\r') {
+    end--;
+  }
+  char* field_begin = begin;
+  while (true) {
+    if (field_begin < end && *field_begin == kQuote) {
+      // quoted field, "" is an escaped quote
+      char* read  = field_begin + 1;
+      char* write = field_begin;
+      while (read < end) {
+        if (*read == kQuote) {
+          if (read + 1 < end && *(read + 1) == kQuote) {
+            *write++ = kQuote;
+            read += 2;
+            continue;
+          }
+          read++;
+          break;
+        }
+        *write++ = *read++;
+      }
+      fields.emplace_back(field_begin, write - field_begin);
+      // skip to the next separator
+      while (read < end && *read != kSeparator) {
+        read++;
+      }
+      if (read >= end) {
+        return;
+      }
+      field_begin = read + 1;
+      continue;
+    }
+    char* field_end = static_cast<char*>(
+        std::memchr(field_begin, kSeparator, end - field_begin));
+    if (!field_end) {
+      fields.emplace_back(field_begin, end - field_begin);
+      return;
+    }
+    fields.emplace_back(field_begin, field_end - field_begin);
+    field_begin = field_end + 1;
+  }
+}
+
+// returns false if the field is empty or cannot be converted
+template <typename DataType>
+inline bool ParseField(std::string_view field, DataType& value) {
+  if (field.empty()) {
+    return false;
+  }
+  if constexpr (std::is_same_v<DataType, std::string>) {
+    value.assign(field.data(), field.size());
+    return true;
+  } else if constexpr (std::is_same_v<DataType, DateTime>) {
+    value = DateTime(std::string(field));
+    return true;
+  } else if constexpr (std::is_same_v<DataType, bool>) {
+    value = (field != "0" && field != "false");
+    return true;
+  } else if constexpr (std::is_arithmetic_v<DataType>) {
+    const char* begin = field.data();
+    const char* end   = field.data() + field.size();
+    if (*begin == '+') {
+      begin++;
+    }
+    auto [ptr, ec] = std::from_chars(begin, end, value);
+    return ec == std::errc() && ptr != begin;
+  } else {
+    std::stringstream ss{std::string(field)};
+    ss >> value;
+    return !ss.fail();
+  }
+}
+
+inline bool ParseCell(std::string_view field, BasicDataType value_type,
+                      CellValue& cell) {
+  if (field.empty()) {
+    cell = std::monostate();
+    return true;
+  }
+  switch (value_type) {
+    case BasicDataType::kTypeString:
+      cell.emplace<std::string>(field);
+      return true;
+    case BasicDataType::kTypeInt:
+      return ParseField(field, cell.emplace<int>());
+    case BasicDataType::kTypeInt64:
+      return ParseField(field, cell.emplace<int64_t>());
+    case BasicDataType::kTypeFloat:
+      return ParseField(field, cell.emplace<float>());
+    case BasicDataType::kTypeDouble:
+      return ParseField(field, cell.emplace<double>());
+    case BasicDataType::kTypeDateTime:
+      return ParseField(field, cell.emplace<DateTime>());
+    default:
+      return false;
+  }
+}
+
+// the rows parsed from one byte range, KeyTuple holds the
+// leading columns in the order taken by the batch api of the
+// graph, e.g. (source_id, target_id, label_id, edge_id)
+template <typename KeyTuple>
+struct RowBlock {
+  std::vector<KeyTuple> key;
+  // attr_num cells for each row
+  std::vector<CellValue> attr;
+  size_t fail_num = 0;
+
+  void Clear() {
+    key.clear();
+    attr.clear();
+    fail_num = 0;
+    return;
+  }
+};
+
+// the idx-th element of the key is read from the col-th column
+template <typename KeyTuple, size_t... col, size_t... idx>
+inline bool ParseKey(const std::vector<std::string_view>& fields,
+                     KeyTuple& key, std::index_sequence<col...>,
+                                    std::index_sequence<idx...>) {
+  return (ParseField(fields[col], std::get<idx>(key)) && ...);
+}
+
+template <typename KeyTuple, typename KeyColumn>
+inline void ParseRange(char* begin, char* end,
+                       const std::vector<BasicDataType>& attr_type,
+                       RowBlock<KeyTuple>& block) {
+  constexpr size_t kKeyNum = std::tuple_size_v<KeyTuple>;
+  const size_t kAttrNum = attr_type.size();
+  block.Clear();
+  std::vector<std::string_view> fields;
+  char* line_begin = begin;
+  while (line_begin < end) {
+    char* line_end = static_cast<char*>(
+        std::memchr(line_begin, '\n', end - line_begin));
+    if (!line_end) {
+      line_end = end;
+    }
+    char* next_line_begin = line_end + 1;
+    if (line_end == line_begin
+     || (line_end == line_begin + 1 && *line_begin == '\r')) {
+      // empty line
+      line_begin = next_line_begin;
+      continue;
+    }
+    SplitLine(line_begin, line_end, fields);
+    line_begin = next_line_begin;
+
+    KeyTuple key;
+    if (fields.size() < kKeyNum
+     || !ParseKey(fields, key, KeyColumn(),
+                              std::make_index_sequence<kKeyNum>())) {
+      block.fail_num++;
+      continue;
+    }
+    const size_t kAttrBegin = block.attr.size();
+    block.attr.resize(kAttrBegin + kAttrNum);
+    bool succeed = true;
+    for (size_t attr_idx = 0; attr_idx < kAttrNum; attr_idx++) {
+      if (kKeyNum + attr_idx >= fields.size()) {
+        // missing cells are null
+        break;
+      }
+      if (!ParseCell(fields[kKeyNum + attr_idx], attr_type[attr_idx],
+                     block.attr[kAttrBegin + attr_idx])) {
+        succeed = false;
+        break;
+      }
+    }
+    if (!succeed) {
+      block.attr.resize(kAttrBegin);
+      block.fail_num++;
+      continue;
+    }
+    block.key.emplace_back(std::move(key));
+  }
+  return;
+}
+
+// reads a file in chunks of complete lines
+class ChunkReader {
+ public:
+  ChunkReader(size_t chunk_size) : chunk_size_(std::max(chunk_size,
+                                                        (size_t)1)) {}
+
+  bool Open(const std::string& file) {
+    in_.open(file, std::ios::binary);
+    return static_cast<bool>(in_);
+  }
+
+  bool ReadLine(std::string& line) {
+    return static_cast<bool>(std::getline(in_, line));
+  }
+
+  // the chunk always ends at the end of a line or the end of
+  // the file, returns false if nothing more can be read
+  bool Next(std::vector<char>& chunk) {
+    chunk.swap(carry_);
+    carry_.clear();
+    while (in_) {
+      const size_t kOldSize = chunk.size();
+      chunk.resize(kOldSize + chunk_size_);
+      in_.read(chunk.data() + kOldSize, chunk_size_);
+      chunk.resize(kOldSize + in_.gcount());
+      if (!in_) {
+        // end of the file
+        break;
+      }
+      auto last_line_end = std::find(chunk.rbegin(),
+                                     chunk.rbegin() + (chunk.size() - kOldSize),
+                                     '\n');
+      if (last_line_end == chunk.rbegin() + (chunk.size() - kOldSize)) {
+        // a line longer than the chunk, keep reading
+        continue;
+      }
+      const size_t kChunkEnd = chunk.rend() - last_line_end;
+      carry_.assign(chunk.begin() + kChunkEnd, chunk.end());
+      chunk.resize(kChunkEnd);
+      break;
+    }
+    return !chunk.empty();
+  }
+
+ private:
+  const size_t chunk_size_;
+  std::ifstream in_;
+  std::vector<char> carry_;
+};
+
+// split the chunk into byte ranges that begin at the begin of a line
+inline std::vector<char*> SplitChunk(std::vector<char>& chunk,
+                                     size_t range_num) {
+  std::vector<char*> range_begin;
+  char* const kBegin = chunk.data();
+  char* const kEnd   = chunk.data() + chunk.size();
+  range_begin.emplace_back(kBegin);
+  for (size_t i = 1; i < range_num; i++) {
+    char* pos = std::max(range_begin.back(),
+                         kBegin + chunk.size() * i / range_num);
+    if (pos >= kEnd) {
+      break;
+    }
+    char* line_end = static_cast<char*>(std::memchr(pos, '\n', kEnd - pos));
+    if (!line_end || line_end + 1 >= kEnd) {
+      break;
+    }
+    if (line_end + 1 > range_begin.back()) {
+      range_begin.emplace_back(line_end + 1);
+    }
+  }
+  range_begin.emplace_back(kEnd);
+  return range_begin;
+}
+
+template <typename HandleType, typename AttributeKeyType>
+inline void AddCellAttributes(
+    HandleType& handle,
+    const std::vector<std::pair<AttributeKeyType, BasicDataType>>& attr_info,
+    size_t attr_begin, const CellValue* cells) {
+  for (size_t attr_idx = 0; attr_idx + attr_begin < attr_info.size();
+              attr_idx++) {
+    const AttributeKeyType& attr_key = attr_info[attr_begin + attr_idx].first;
+    std::visit(
+        [&handle, &attr_key](const auto& value) {
+          using ValueType = std::decay_t<decltype(value)>;
+          if constexpr (!std::is_same_v<ValueType, std::monostate>) {
+            handle->AddAttribute(attr_key, value);
+          }
+          return;
+        },
+        cells[attr_idx]);
+  }
+  return;
+}
+
+// read the file chunk by chunk, parse each chunk with thread_num
+// threads and then add the rows of the chunk together with
+// add_rows(keys, cells, fail_num) serially
+// returns the number of rows added, or a negative value if failed
+template <typename KeyTuple, typename KeyColumn, typename AddRowsCallback>
+inline int ReadRows(ChunkReader& reader,
+                    const std::vector<BasicDataType>& attr_type,
+                    int thread_num, AddRowsCallback add_rows,
+                    size_t& fail_num) {
+  const int kThreadNum = std::max(thread_num, 1);
+  std::vector<char> chunk;
+  std::vector<RowBlock<KeyTuple>> blocks(kThreadNum);
+  int count_success = 0;
+  while (reader.Next(chunk)) {
+    std::vector<char*> range_begin = SplitChunk(chunk, blocks.size());
+    const int kRangeNum = range_begin.size() - 1;
+    #pragma omp parallel for schedule(static, 1) num_threads(kThreadNum)
+    for (int range_idx = 0; range_idx < kRangeNum; range_idx++) {
+      ParseRange<KeyTuple, KeyColumn>(range_begin[range_idx],
+                                      range_begin[range_idx + 1],
+                                      attr_type, blocks[range_idx]);
+    }
+    // gather the rows into the first block to add them in one batch
+    auto& rows = blocks[0];
+    for (int range_idx = 1; range_idx < kRangeNum; range_idx++) {
+      auto& block = blocks[range_idx];
+      rows.fail_num += block.fail_num;
+      rows.key.insert(rows.key.end(),
+                      std::make_move_iterator(block.key.begin()),
+                      std::make_move_iterator(block.key.end()));
+      rows.attr.insert(rows.attr.end(),
+                       std::make_move_iterator(block.attr.begin()),
+                       std::make_move_iterator(block.attr.end()));
+      block.Clear();
+    }
+    fail_num += rows.fail_num;
+    int ret = add_rows(rows.key, rows.attr.data(), fail_num);
+    if (ret < 0) {
+      return ret;
+    }
+    count_success += ret;
+    rows.Clear();
+  }
+  return count_success;
+}
+
+// whether the graph supports AddVertexBatch/AddEdgeBatch, otherwise
+// the rows are added one by one
+template <typename GraphType, typename = void>
+struct HasAddVertexBatch : std::false_type {};
+
+template <typename GraphType>
+struct HasAddVertexBatch<GraphType,
+    std::void_t<decltype(std::declval<GraphType&>().AddVertexBatch(
+        std::declval<const std::vector<
+            std::pair<typename GraphType::VertexType::IDType,
+                      typename GraphType::VertexType::LabelType>>&>()))>>
+    : std::true_type {};
+
+template <typename GraphType, typename = void>
+struct HasAddEdgeBatch : std::false_type {};
+
+template <typename GraphType>
+struct HasAddEdgeBatch<GraphType,
+    std::void_t<decltype(std::declval<GraphType&>().AddEdgeBatch(
+        std::declval<const std::vector<
+            std::tuple<typename GraphType::VertexType::IDType,
+                       typename GraphType::VertexType::IDType,
+                       typename GraphType::EdgeType::LabelType,
+                       typename GraphType::EdgeType::IDType>>&>()))>>
+    : std::true_type {};
+
+// whether the graph supports BeginBulkLoad/EndBulkLoad, the edges of
+// a file are then linked into the adjacency all together after it is
+// read
+template <typename GraphType, typename = void>
+struct HasBulkLoad : std::false_type {};
+
+template <typename GraphType>
+struct HasBulkLoad<GraphType,
+    std::void_t<decltype(std::declval<GraphType&>().BeginBulkLoad()),
+                decltype(std::declval<GraphType&>().EndBulkLoad()),
+                decltype(std::declval<GraphType&>().IsBulkLoading())>>
+    : std::true_type {};
+
+inline bool ReadHeader(ChunkReader& reader,
+                       std::vector<std::string>& col_name) {
+  std::string header;
+  if (!reader.ReadLine(header)) {
+    return false;
+  }
+  std::vector<std::string_view> fields;
+  SplitLine(header.data(), header.data() + header.size(), fields);
+  col_name.clear();
+  for (const auto& field : fields) {
+    col_name.emplace_back(field);
+  }
+  return true;
+}
+
+template <typename AttributeKeyType>
+inline std::vector<BasicDataType> AttributeTypes(
+    const std::vector<std::pair<AttributeKeyType, BasicDataType>>& attr_info,
+    size_t attr_begin, bool read_attr) {
+  std::vector<BasicDataType> attr_type;
+  if (!read_attr) {
+    return attr_type;
+  }
+  for (size_t i = attr_begin; i < attr_info.size(); i++) {
+    attr_type.emplace_back(attr_info[i].second);
+  }
+  return attr_type;
+}
+
+}  // namespace _csv_parallel
+
+template <bool read_attr = true, class GraphType, class ReadVertexCallback>
+int ReadCSVVertexFileParallelWithCallback(
+    const std::string& v_file, GraphType& graph,
+    ReadVertexCallback callback, int thread_num = omp_get_max_threads(),
+    size_t chunk_size = _csv_parallel::kDefaultChunkSize) {
+  // read vertex file(csv)
+  // file format: (vertex_id,label_id,......)
+  using VertexIDType = typename GraphType::VertexType::IDType;
+  using VertexLabelType = typename GraphType::VertexType::LabelType;
+  using VertexAttributeKeyType =
+      typename GraphType::VertexType::AttributeKeyType;
+
+  using KeyTuple = std::pair<VertexIDType, VertexLabelType>;
+  // (vertex_id, label_id)
+  using KeyColumn = std::index_sequence<0, 1>;
+
+  _csv_parallel::ChunkReader reader(chunk_size);
+  if (!reader.Open(v_file)) {
+    std::cout << "cannot open file: " << v_file << std::endl;
+    return -1;
+  }
+
+  // phase column names
+  std::vector<std::string> col_name;
+  std::vector<std::pair<VertexAttributeKeyType, enum BasicDataType>>
+      attr_info;
+  if (!_csv_parallel::ReadHeader(reader, col_name)
+   || !GetAttributeInfo(col_name, attr_info)) {
+    std::cout << "Attribute key type is not correct!" << std::endl;
+    return -1;
+  }
+
+  size_t col_num = attr_info.size();
+  // check col num >= 2
+  if (col_num < 2 || attr_info[0].first != "vertex_id" ||
+      attr_info[1].first != "label_id") {
+    std::cout << "Vertex file does not have vertex_id or label_id!"
+              << std::endl;
+    return -1;
+  }
+  // check attributes
+  if constexpr (read_attr && !GraphParameter<GraphType>::vertex_has_attribute) {
+    if (col_num >= 3) {
+      std::cout << "vertex file has attribute but graph does not support!"
+                << std::endl;
+      return -1;
+    }
+  }
+
+  const std::vector<BasicDataType> kAttrType
+      = _csv_parallel::AttributeTypes(attr_info, 2, read_attr);
+
+  size_t count_fail = 0;
+  const size_t kAttrNum = kAttrType.size();
+  int count_success = _csv_parallel::ReadRows<KeyTuple, KeyColumn>(
+      reader, kAttrType, thread_num,
+      [&graph, &attr_info, &callback, &kAttrNum](
+          const std::vector<KeyTuple>& keys,
+          const _csv_parallel::CellValue* cells, size_t& fail_num) {
+        using VertexHandleType = typename VertexHandle<GraphType>::type;
+        std::vector<std::pair<VertexHandleType, bool>> added;
+        if constexpr (_csv_parallel::HasAddVertexBatch<GraphType>::value) {
+          added = graph.AddVertexBatch(keys);
+        } else {
+          added.reserve(keys.size());
+          for (const auto& [vertex_id, label_id] : keys) {
+            added.emplace_back(graph.AddVertex(vertex_id, label_id));
+          }
+        }
+        int count = 0;
+        for (size_t row = 0; row < added.size(); row++) {
+          auto& [vertex_handle, r] = added[row];
+          if (!r) {
+            fail_num++;
+            continue;
+          }
+          if constexpr (read_attr
+                     && GraphParameter<GraphType>::vertex_has_attribute) {
+            _csv_parallel::AddCellAttributes(vertex_handle, attr_info,
+                                             2, cells + row * kAttrNum);
+          }
+          if constexpr (!std::is_null_pointer_v<ReadVertexCallback>) {
+            if (!callback(vertex_handle)) return -2;
+          }
+          count++;
+        }
+        return count;
+      },
+      count_fail);
+  if (count_fail > 0) {
+    std::cout << "load vertex file failed: " << count_fail << std::endl;
+  }
+  return count_success;
+}
+
+template <bool read_attr = true, class GraphType, class ReadEdgeCallback>
+int ReadCSVEdgeFileParallelWithCallback(
+    const std::string& e_file, GraphType& graph,
+    ReadEdgeCallback callback, int thread_num = omp_get_max_threads(),
+    size_t chunk_size = _csv_parallel::kDefaultChunkSize) {
+  // read edge file(csv)
+  // file format: (edge_id,source_id,target_id,label_id,......)
+  using VertexIDType = typename GraphType::VertexType::IDType;
+  using EdgeIDType = typename GraphType::EdgeType::IDType;
+  using EdgeLabelType = typename GraphType::EdgeType::LabelType;
+  using EdgeAttributeKeyType = typename GraphType::EdgeType::AttributeKeyType;
+
+  using KeyTuple = std::tuple<VertexIDType, VertexIDType,
+                              EdgeLabelType, EdgeIDType>;
+  // (source_id, target_id, label_id, edge_id)
+  using KeyColumn = std::index_sequence<1, 2, 3, 0>;
+
+  _csv_parallel::ChunkReader reader(chunk_size);
+  if (!reader.Open(e_file)) {
+    std::cout << "cannot open file: " << e_file << std::endl;
+    return -1;
+  }
+
+  // phase column names
+  std::vector<std::string> col_name;
+  std::vector<std::pair<EdgeAttributeKeyType, enum BasicDataType>> attr_info;
+  if (!_csv_parallel::ReadHeader(reader, col_name)
+   || !GetAttributeInfo(col_name, attr_info)) {
+    std::cout << "Attribute key type is not correct!" << std::endl;
+    return -1;
+  }
+
+  size_t col_num = attr_info.size();
+  // check col_num >= 4
+  if (col_num < 4
+   || attr_info[0].first != "edge_id"
+   || attr_info[1].first != "source_id"
+   || attr_info[2].first != "target_id"
+   || attr_info[3].first != "label_id") {
+    std::cout << "edge file is not correct!(col num must >=4)" << std::endl;
+    return -1;
+  }
+
+  if constexpr (read_attr && !GraphParameter<GraphType>::edge_has_attribute) {
+    if (col_num >= 5) {
+      std::cout << "Edge file has attribute but graph does not support!"
+                << std::endl;
+      return -1;
+    }
+  }
+
+  const std::vector<BasicDataType> kAttrType
+      = _csv_parallel::AttributeTypes(attr_info, 4, read_attr);
+
+  // the bulk load started by the caller is left to the caller to end
+  bool end_bulk_load = false;
+  if constexpr (_csv_parallel::HasBulkLoad<GraphType>::value) {
+    if (!graph.IsBulkLoading()) {
+      graph.BeginBulkLoad();
+      end_bulk_load = true;
+    }
+  }
+
+  size_t count_fail = 0;
+  const size_t kAttrNum = kAttrType.size();
+  int count_success = _csv_parallel::ReadRows<KeyTuple, KeyColumn>(
+      reader, kAttrType, thread_num,
+      [&graph, &attr_info, &callback, &kAttrNum](
+          const std::vector<KeyTuple>& keys,
+          const _csv_parallel::CellValue* cells, size_t& fail_num) {
+        using EdgeHandleType = typename EdgeHandle<GraphType>::type;
+        std::vector<std::pair<EdgeHandleType, bool>> added;
+        if constexpr (_csv_parallel::HasAddEdgeBatch<GraphType>::value) {
+          added = graph.AddEdgeBatch(keys);
+        } else {
+          added.reserve(keys.size());
+          for (const auto& [src_id, dst_id, label_id, edge_id] : keys) {
+            added.emplace_back(graph.AddEdge(src_id, dst_id,
+                                             label_id, edge_id));
+          }
+        }
+        int count = 0;
+        for (size_t row = 0; row < added.size(); row++) {
+          auto& [edge_handle, r] = added[row];
+          if (!r) {
+            fail_num++;
+            continue;
+          }
+          if constexpr (read_attr
+                     && GraphParameter<GraphType>::edge_has_attribute) {
+            _csv_parallel::AddCellAttributes(edge_handle, attr_info,
+                                             4, cells + row * kAttrNum);
+          }
+          if constexpr (!std::is_null_pointer_v<ReadEdgeCallback>) {
+            if (!callback(edge_handle)) return -2;
+          }
+          count++;
+        }
+        return count;
+      },
+      count_fail);
+  if constexpr (_csv_parallel::HasBulkLoad<GraphType>::value) {
+    if (end_bulk_load) {
+      graph.EndBulkLoad();
+    }
+  }
+  if (count_fail > 0) {
+    std::cout << "load edge file failed: " << count_fail << std::endl;
+  }
+  return count_success;
+}
+
+template <bool read_vertex_attr = true,
+          bool read_edge_attr   = true, class GraphType>
+inline int ReadCSVGraphParallel(
+    GraphType& graph,
+    const std::vector<std::string>& v_list,
+    const std::vector<std::string>& e_list,
+    int thread_num = omp_get_max_threads(),
+    size_t chunk_size = _csv_parallel::kDefaultChunkSize) {
+  int count_v = 0;
+  for (const auto& v_file : v_list) {
+    int res = ReadCSVVertexFileParallelWithCallback<read_vertex_attr>(
+        v_file, graph, nullptr, thread_num, chunk_size);
+    if (res < 0) return res;
+    count_v += res;
+  }
+
+  int count_e = 0;
+  for (const auto& e_file : e_list) {
+    int res = ReadCSVEdgeFileParallelWithCallback<read_edge_attr>(
+        e_file, graph, nullptr, thread_num, chunk_size);
+    if (res < 0) return res;
+    count_e += res;
+  }
+
+  std::cout << " Vertex: " << count_v << std::endl;
+  std::cout << "   Edge: " << count_e << std::endl;
+
+  return count_v + count_e;
+}
+
+template <bool read_vertex_attr = true,
+          bool read_edge_attr   = true, class GraphType>
+inline int ReadCSVGraphParallel(
+    GraphType& graph,
+    const std::string& v_file,
+    const std::string& e_file,
+    int thread_num = omp_get_max_threads(),
+    size_t chunk_size = _csv_parallel::kDefaultChunkSize) {
+  std::vector<std::string> v_list, e_list;
+  v_list.push_back(v_file);
+  e_list.push_back(e_file);
+  return ReadCSVGraphParallel<read_vertex_attr,
+                              read_edge_attr>(graph, v_list, e_list,
+                                              thread_num, chunk_size);
+}
+
+}  // namespace GUNDAM
+
+#endif  // _GUNDAM_IO_CSVGRAPH_PARALLEL_H
@@ -0,0 +1,1327 @@
+#ifndef _GUNDAM_IO_GRAPH_SNAPSHOT_H
+#define _GUNDAM_IO_GRAPH_SNAPSHOT_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define _GUNDAM_GRAPH_SNAPSHOT_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "gundam/data_type/datatype.h"
+#include "gundam/data_type/datetime.h"
+#include "gundam/graph_type/csr_graph.h"
+#include "gundam/type_getter/edge_handle.h"
+#include "gundam/type_getter/graph_parameter_getter.h"
+#include "gundam/type_getter/vertex_handle.h"
+
+// binary snapshot of a graph, laid out as the arrays held in CSRGraph
+// so that it can be served directly from the mapped file
+//
+//   header
+//   section table
+//   sections, each one starts at an offset aligned to 8 bytes
+//
+// structural sections, V for the vertex number and E for the edge number
+//   vertex id           V * sizeof(VertexIDType),   sorted by (label, id)
+//   vertex label        V * sizeof(VertexLabelType)
+//   vertex id order     V * uint64_t, vertex index sorted by id
+//   edge id             E * sizeof(EdgeIDType),
+//                       sorted by (src, edge label, dst label, dst, id)
+//   edge label          E * sizeof(EdgeLabelType)
+//   edge src            E * uint64_t, vertex index
+//   edge dst            E * uint64_t, vertex index
+//   edge id order       E * uint64_t, edge index sorted by id
+//   out offset      (V+1) * uint64_t, out edges of vertex i are the edges
+//                                     in [out_offset[i], out_offset[i+1])
+//   in offset       (V+1) * uint64_t, in edges of vertex i are in_edge[j]
+//                                     for j in [in_offset[i], in_offset[i+1])
+//   in edge             E * uint64_t, edge index sorted by
+//                                     (dst, edge label, src label, src, id)
+//   column table        ColumnEntry for each attribute column
+//
+// each attribute column holds the value of one attribute key for all
+// vertexes (or edges), a bit in the null bitmap is set if the element
+// has the attribute. the values are stored in fixed width, as int64_t
+// for DateTime, and as V+1 (or E+1) uint64_t offsets into a char blob
+// for string
+//
+// all values are stored in the byte order of the writer
+
+namespace GUNDAM {
+
+namespace _graph_snapshot {
+
+constexpr char kMagic[8] = {'G', 'U', 'N', 'D', 'A', 'M', 'S', 'S'};
+
+constexpr uint32_t kVersion = 1;
+
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+constexpr uint64_t kAlignment = 8;
+
+enum class SectionKind : uint32_t {
+  kVertexID      =  1,
+  kVertexLabel   =  2,
+  kVertexIDOrder =  3,
+  kEdgeID        =  4,
+  kEdgeLabel     =  5,
+  kEdgeSrc       =  6,
+  kEdgeDst       =  7,
+  kEdgeIDOrder   =  8,
+  kOutOffset     =  9,
+  kInOffset      = 10,
+  kInEdge        = 11,
+  kColumnTable   = 12,
+  kColumnData    = 13
+};
+
+constexpr uint32_t kStructuralSectionNum = 11;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order_mark;
+  uint32_t header_size;
+  uint32_t section_num;
+  uint32_t vertex_id_type;
+  uint32_t vertex_label_type;
+  uint32_t edge_id_type;
+  uint32_t edge_label_type;
+  uint64_t vertex_num;
+  uint64_t edge_num;
+  uint64_t vertex_column_num;
+  uint64_t edge_column_num;
+};
+
+struct SectionEntry {
+  uint32_t kind;
+  uint32_t reserved;
+  uint64_t offset;
+  uint64_t size;
+};
+
+// all offsets are relative to the begin of the file
+struct ColumnEntry {
+  uint32_t is_edge;
+  int32_t value_type;
+  uint64_t key_offset;
+  uint64_t key_size;
+  uint64_t null_offset;
+  uint64_t value_offset;
+  uint64_t value_size;
+  uint64_t data_offset;
+  uint64_t data_size;
+};
+
+static_assert(sizeof(Header) % kAlignment == 0);
+static_assert(sizeof(SectionEntry) % kAlignment == 0);
+static_assert(sizeof(ColumnEntry) % kAlignment == 0);
+
+inline constexpr uint64_t AlignUp(uint64_t offset) {
+  return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+// the kind and width of the id and label types, a snapshot can
+// only be read with the same types as it was written
+template <typename DataType>
+inline constexpr uint32_t TypeCode() {
+  static_assert(std::is_arithmetic_v<DataType>,
+                "only arithmetic id and label types are supported");
+  return ((std::is_floating_point_v<DataType> ? 3
+         : std::is_signed_v<DataType>         ? 2 : 1) << 8)
+        | sizeof(DataType);
+}
+
+inline size_t ValueWidth(BasicDataType value_type) {
+  switch (value_type) {
+    case BasicDataType::kTypeInt:
+      return sizeof(int);
+    case BasicDataType::kTypeInt64:
+      return sizeof(int64_t);
+    case BasicDataType::kTypeFloat:
+      return sizeof(float);
+    case BasicDataType::kTypeDouble:
+      return sizeof(double);
+    case BasicDataType::kTypeDateTime:
+      return sizeof(int64_t);
+    case BasicDataType::kTypeBool:
+      return sizeof(bool);
+    case BasicDataType::kTypeChar:
+      return sizeof(char);
+    default:
+      // string and unknown types are not stored in fixed width
+      return 0;
+  }
+}
+
+template <typename KeyType>
+inline KeyType StringToKey(const std::string& key_str) {
+  if constexpr (std::is_same_v<KeyType, std::string>) {
+    return key_str;
+  } else {
+    KeyType key;
+    std::stringstream ss(key_str);
+    ss >> key;
+    return key;
+  }
+}
+
+// values of one attribute key collected by the writer, the
+// elements are visited in the order of the index
+class ColumnBuilder {
+ public:
+  ColumnBuilder(BasicDataType value_type, size_t element_num)
+      : value_type_(value_type),
+        element_num_(element_num),
+        filled_num_(0),
+        null_bitmap_((element_num + 63) / 64, 0) {
+    if (value_type == BasicDataType::kTypeString) {
+      offset_.resize(element_num + 1, 0);
+      return;
+    }
+    value_.resize(element_num * ValueWidth(value_type), 0);
+    return;
+  }
+
+  BasicDataType value_type() const { return value_type_; }
+
+  template <typename AttributeHandle>
+  void Set(size_t idx, const AttributeHandle& attr_handle) {
+    assert(idx < element_num_ && idx >= filled_num_);
+    null_bitmap_[idx / 64] |= (uint64_t)1 << (idx % 64);
+    switch (value_type_) {
+      case BasicDataType::kTypeString: {
+        const std::string& str
+            = attr_handle->template const_value<std::string>();
+        for (; filled_num_ <= idx; filled_num_++) {
+          offset_[filled_num_] = data_.size();
+        }
+        data_.append(str);
+        return;
+      }
+      case BasicDataType::kTypeInt:
+        this->SetValue(idx, attr_handle->template const_value<int>());
+        break;
+      case BasicDataType::kTypeInt64:
+        this->SetValue(idx, attr_handle->template const_value<int64_t>());
+        break;
+      case BasicDataType::kTypeFloat:
+        this->SetValue(idx, attr_handle->template const_value<float>());
+        break;
+      case BasicDataType::kTypeDouble:
+        this->SetValue(idx, attr_handle->template const_value<double>());
+        break;
+      case BasicDataType::kTypeDateTime:
+        this->SetValue(idx, (int64_t)attr_handle->template
+                                const_value<DateTime>().to_time_t());
+        break;
+      case BasicDataType::kTypeBool:
+        this->SetValue(idx, attr_handle->template const_value<bool>());
+        break;
+      case BasicDataType::kTypeChar:
+        this->SetValue(idx, attr_handle->template const_value<char>());
+        break;
+      default:
+        assert(false);
+        break;
+    }
+    filled_num_ = idx + 1;
+    return;
+  }
+
+  void Finish() {
+    if (value_type_ != BasicDataType::kTypeString) {
+      return;
+    }
+    for (; filled_num_ <= element_num_; filled_num_++) {
+      offset_[filled_num_] = data_.size();
+    }
+    return;
+  }
+
+  const std::vector<uint64_t>& null_bitmap() const { return null_bitmap_; }
+
+  const void* value_data() const {
+    return value_type_ == BasicDataType::kTypeString
+         ? static_cast<const void*>(offset_.data())
+         : static_cast<const void*>(value_.data());
+  }
+
+  uint64_t value_size() const {
+    return value_type_ == BasicDataType::kTypeString
+         ? offset_.size() * sizeof(uint64_t)
+         : value_.size();
+  }
+
+  const std::string& data() const { return data_; }
+
+ private:
+  template <typename ValueType>
+  inline void SetValue(size_t idx, const ValueType& value) {
+    assert(sizeof(ValueType) == ValueWidth(value_type_));
+    std::memcpy(value_.data() + idx * sizeof(ValueType), &value,
+                sizeof(ValueType));
+    return;
+  }
+
+  BasicDataType value_type_;
+  size_t element_num_;
+  size_t filled_num_;
+  std::vector<uint64_t> null_bitmap_;
+  std::vector<char> value_;
+  std::vector<uint64_t> offset_;
+  std::string data_;
+};
+
+// collect the attributes of the elements in the order given
+// returns false if the values of one key have different types
+template <bool is_edge, typename HandleContainer>
+inline bool BuildColumns(const HandleContainer& handles,
+                         std::map<std::string, ColumnBuilder>& columns) {
+  for (size_t idx = 0; idx < handles.size(); idx++) {
+    for (auto attr_it = handles[idx]->AttributeBegin();
+             !attr_it.IsDone();
+              attr_it++) {
+      const BasicDataType kValueType = attr_it->value_type();
+      if (kValueType == BasicDataType::kTypeUnknown) {
+        std::cout << "unknown attribute type of key: "
+                  << ToString(attr_it->key()) << std::endl;
+        return false;
+      }
+      auto [column_it, column_ret] = columns.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(ToString(attr_it->key())),
+          std::forward_as_tuple(kValueType, handles.size()));
+      if (column_it->second.value_type() != kValueType) {
+        std::cout << (is_edge ? "edge" : "vertex")
+                  << " attribute has different types of key: "
+                  << column_it->first << std::endl;
+        return false;
+      }
+      column_it->second.Set(idx, attr_it);
+    }
+  }
+  for (auto& [key, column] : columns) {
+    column.Finish();
+  }
+  return true;
+}
+
+// read-only mapping of a snapshot file, the whole file is read into
+// memory on the platforms without mmap
+class MappedFile {
+ public:
+  MappedFile() : data_(nullptr), size_(0) {}
+
+  MappedFile(const MappedFile&) = delete;
+
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() { this->Close(); }
+
+  bool Open(const std::string& file) {
+    this->Close();
+#ifdef _GUNDAM_GRAPH_SNAPSHOT_MMAP
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+      ::close(fd);
+      return false;
+    }
+    void* addr = ::mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED,
+                        fd, 0);
+    // the mapping is still valid after the file is closed
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+      return false;
+    }
+    data_ = static_cast<const char*>(addr);
+    size_ = file_stat.st_size;
+#else
+    std::ifstream in(file, std::ios::binary | std::ios::ate);
+    if (!in) {
+      return false;
+    }
+    std::streamsize file_size = in.tellg();
+    if (file_size <= 0) {
+      return false;
+    }
+    // uint64_t to keep the sections aligned
+    buffer_.resize((file_size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(buffer_.data()), file_size)) {
+      std::vector<uint64_t>().swap(buffer_);
+      return false;
+    }
+    data_ = reinterpret_cast<const char*>(buffer_.data());
+    size_ = file_size;
+#endif
+    return true;
+  }
+
+  void Close() {
+    if (!data_) {
+      return;
+    }
+#ifdef _GUNDAM_GRAPH_SNAPSHOT_MMAP
+    ::munmap(const_cast<char*>(data_), size_);
+#else
+    std::vector<uint64_t>().swap(buffer_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    return;
+  }
+
+  const char* data() const { return data_; }
+
+  size_t size() const { return size_; }
+
+ private:
+  const char* data_;
+  size_t size_;
+#ifndef _GUNDAM_GRAPH_SNAPSHOT_MMAP
+  std::vector<uint64_t> buffer_;
+#endif
+};
+
+}  // namespace _graph_snapshot
+
+// view of a typed array inside the snapshot
+template <typename DataType>
+class SnapshotArray {
+ public:
+  SnapshotArray() : data_(nullptr), size_(0) {}
+
+  SnapshotArray(const DataType* data, size_t size) : data_(data), size_(size) {}
+
+  const DataType* data() const { return data_; }
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  const DataType& operator[](size_t idx) const {
+    assert(idx < size_);
+    return data_[idx];
+  }
+
+  const DataType* begin() const { return data_; }
+
+  const DataType* end() const { return data_ + size_; }
+
+ private:
+  const DataType* data_;
+  size_t size_;
+};
+
+// one attribute key of all vertexes or all edges, the values are read
+// from the snapshot without being copied
+template <typename AttributeKeyType>
+class SnapshotColumn {
+ public:
+  using KeyType = AttributeKeyType;
+
+  SnapshotColumn(const AttributeKeyType& key, BasicDataType value_type,
+                 const uint64_t* null_bitmap, const char* value,
+                 const char* data)
+      : key_(key),
+        value_type_(value_type),
+        null_bitmap_(null_bitmap),
+        value_(value),
+        data_(data) {}
+
+  const AttributeKeyType& key() const { return key_; }
+
+  BasicDataType value_type() const { return value_type_; }
+
+  bool IsNull(size_t idx) const {
+    return !(null_bitmap_[idx / 64] & ((uint64_t)1 << (idx % 64)));
+  }
+
+  std::string_view string_value(size_t idx) const {
+    assert(value_type_ == BasicDataType::kTypeString);
+    uint64_t begin, end;
+    std::memcpy(&begin, value_ + idx * sizeof(uint64_t), sizeof(uint64_t));
+    std::memcpy(&end, value_ + (idx + 1) * sizeof(uint64_t),
+                sizeof(uint64_t));
+    return std::string_view(data_ + begin, end - begin);
+  }
+
+  // the value of a null element is the zero value of the type
+  template <typename ConcreteDataType>
+  ConcreteDataType value(size_t idx) const {
+    assert(TypeToEnum<ConcreteDataType>() == value_type_);
+    if constexpr (std::is_same_v<ConcreteDataType, std::string>) {
+      return std::string(this->string_value(idx));
+    } else if constexpr (std::is_same_v<ConcreteDataType, DateTime>) {
+      int64_t t;
+      std::memcpy(&t, value_ + idx * sizeof(int64_t), sizeof(int64_t));
+      return DateTime((time_t)t);
+    } else {
+      return reinterpret_cast<const ConcreteDataType*>(value_)[idx];
+    }
+  }
+
+ private:
+  AttributeKeyType key_;
+  BasicDataType value_type_;
+  const uint64_t* null_bitmap_;
+  const char* value_;
+  const char* data_;
+};
+
+// read-only graph served from a memory-mapped snapshot file, the
+// id and label types should be the same as the graph it is written
+// from, the attribute keys are converted from string
+template <class VertexIDType,
+          class VertexLabelType,
+          class EdgeIDType,
+          class EdgeLabelType,
+          class VertexAttributeKeyType = std::string,
+          class   EdgeAttributeKeyType = std::string>
+class GraphSnapshot {
+ public:
+  using VertexColumn = SnapshotColumn<VertexAttributeKeyType>;
+
+  using EdgeColumn = SnapshotColumn<EdgeAttributeKeyType>;
+
+  static constexpr size_t kNoIndex = (size_t)-1;
+
+  GraphSnapshot() : vertex_num_(0), edge_num_(0) {}
+
+  GraphSnapshot(const GraphSnapshot&) = delete;
+
+  GraphSnapshot& operator=(const GraphSnapshot&) = delete;
+
+  // returns 0 if succeed, a negative value otherwise
+  //   -1: cannot open or map the file
+  //   -2: not a snapshot or written with another version or byte order
+  //   -3: id or label types are not the same as the ones written
+  //   -4: the file is truncated or corrupted
+  int Open(const std::string& file) {
+    using namespace _graph_snapshot;
+    this->Close();
+    if (!file_.Open(file)) {
+      std::cout << "cannot open snapshot: " << file << std::endl;
+      return -1;
+    }
+    int res = this->Parse();
+    if (res < 0) {
+      std::cout << "cannot load snapshot: " << file
+                << " error: " << res << std::endl;
+      this->Close();
+      return res;
+    }
+    return 0;
+  }
+
+  void Close() {
+    vertex_columns_.clear();
+      edge_columns_.clear();
+    vertex_num_ = 0;
+      edge_num_ = 0;
+    vertex_id_ = {};
+    vertex_label_ = {};
+    vertex_id_order_ = {};
+    edge_id_ = {};
+    edge_label_ = {};
+    edge_src_ = {};
+    edge_dst_ = {};
+    edge_id_order_ = {};
+    out_offset_ = {};
+     in_offset_ = {};
+     in_edge_ = {};
+    file_.Close();
+    return;
+  }
+
+  bool IsOpen() const { return file_.data() != nullptr; }
+
+  size_t CountVertex() const { return vertex_num_; }
+
+  size_t CountEdge() const { return edge_num_; }
+
+  // sorted by (label, id)
+  const SnapshotArray<VertexIDType>& vertex_id() const { return vertex_id_; }
+
+  const SnapshotArray<VertexLabelType>& vertex_label() const {
+    return vertex_label_;
+  }
+
+  // vertex index sorted by id
+  const SnapshotArray<uint64_t>& vertex_id_order() const {
+    return vertex_id_order_;
+  }
+
+  // sorted by (src, edge label, dst label, dst, id)
+  const SnapshotArray<EdgeIDType>& edge_id() const { return edge_id_; }
+
+  const SnapshotArray<EdgeLabelType>& edge_label() const {
+    return edge_label_;
+  }
+
+  // vertex index of the src of each edge
+  const SnapshotArray<uint64_t>& edge_src() const { return edge_src_; }
+
+  // vertex index of the dst of each edge
+  const SnapshotArray<uint64_t>& edge_dst() const { return edge_dst_; }
+
+  // edge index sorted by id
+  const SnapshotArray<uint64_t>& edge_id_order() const {
+    return edge_id_order_;
+  }
+
+  // out edges of vertex i are the edges in [out_offset[i], out_offset[i+1])
+  const SnapshotArray<uint64_t>& out_offset() const { return out_offset_; }
+
+  // in edges of vertex i are in_edge[j] for j in [in_offset[i], in_offset[i+1])
+  const SnapshotArray<uint64_t>& in_offset() const { return in_offset_; }
+
+  // edge index sorted by (dst, edge label, src label, src, id)
+  const SnapshotArray<uint64_t>& in_edge() const { return in_edge_; }
+
+  // returns kNoIndex if not found
+  size_t FindVertex(const VertexIDType& id) const {
+    auto it = std::lower_bound(
+        vertex_id_order_.begin(), vertex_id_order_.end(), id,
+        [this](uint64_t idx, const VertexIDType& vertex_id) {
+          return vertex_id_[idx] < vertex_id;
+        });
+    if (it == vertex_id_order_.end() || vertex_id_[*it] != id) {
+      return kNoIndex;
+    }
+    return *it;
+  }
+
+  // returns kNoIndex if not found
+  size_t FindEdge(const EdgeIDType& id) const {
+    auto it = std::lower_bound(
+        edge_id_order_.begin(), edge_id_order_.end(), id,
+        [this](uint64_t idx, const EdgeIDType& edge_id) {
+          return edge_id_[idx] < edge_id;
+        });
+    if (it == edge_id_order_.end() || edge_id_[*it] != id) {
+      return kNoIndex;
+    }
+    return *it;
+  }
+
+  const std::vector<VertexColumn>& vertex_columns() const {
+    return vertex_columns_;
+  }
+
+  const std::vector<EdgeColumn>& edge_columns() const {
+    return edge_columns_;
+  }
+
+  // returns nullptr if not found, the column can be held
+  // until the snapshot is closed
+  const VertexColumn* FindVertexColumn(
+      const VertexAttributeKeyType& key) const {
+    for (const auto& column : vertex_columns_) {
+      if (column.key() == key) {
+        return &column;
+      }
+    }
+    return nullptr;
+  }
+
+  const EdgeColumn* FindEdgeColumn(const EdgeAttributeKeyType& key) const {
+    for (const auto& column : edge_columns_) {
+      if (column.key() == key) {
+        return &column;
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  inline bool InFile(uint64_t offset, uint64_t size) const {
+    return offset <= file_.size() && size <= file_.size() - offset;
+  }
+
+  template <typename DataType>
+  inline bool SetArray(SnapshotArray<DataType>& array,
+                       const _graph_snapshot::SectionEntry& section,
+                       uint64_t element_num) {
+    if (section.offset % _graph_snapshot::kAlignment != 0
+     || section.size != element_num * sizeof(DataType)
+     || !this->InFile(section.offset, section.size)) {
+      return false;
+    }
+    array = SnapshotArray<DataType>(
+        reinterpret_cast<const DataType*>(file_.data() + section.offset),
+        element_num);
+    return true;
+  }
+
+  template <typename ColumnType>
+  inline int AddColumn(const _graph_snapshot::ColumnEntry& entry,
+                       uint64_t element_num,
+                       std::vector<ColumnType>& columns) {
+    using namespace _graph_snapshot;
+    const BasicDataType kValueType
+        = static_cast<BasicDataType>(entry.value_type);
+    const uint64_t kValueSize
+        = kValueType == BasicDataType::kTypeString
+        ? (element_num + 1) * sizeof(uint64_t)
+        : element_num * ValueWidth(kValueType);
+    if (kValueType != BasicDataType::kTypeString
+     && ValueWidth(kValueType) == 0) {
+      return -4;
+    }
+    if (!this->InFile(entry.key_offset, entry.key_size)
+     || !this->InFile(entry.null_offset, (element_num + 63) / 64 * 8)
+     || entry.null_offset % kAlignment != 0
+     || entry.value_size != kValueSize
+     || !this->InFile(entry.value_offset, entry.value_size)
+     || entry.value_offset % kAlignment != 0
+     || !this->InFile(entry.data_offset, entry.data_size)) {
+      return -4;
+    }
+    if (kValueType == BasicDataType::kTypeString && element_num > 0) {
+      uint64_t last_offset;
+      std::memcpy(&last_offset,
+                  file_.data() + entry.value_offset
+                               + element_num * sizeof(uint64_t),
+                  sizeof(uint64_t));
+      if (last_offset > entry.data_size) {
+        return -4;
+      }
+    }
+    columns.emplace_back(
+        StringToKey<typename ColumnType::KeyType>(std::string(
+            file_.data() + entry.key_offset, entry.key_size)),
+        kValueType,
+        reinterpret_cast<const uint64_t*>(file_.data() + entry.null_offset),
+        file_.data() + entry.value_offset,
+        file_.data() + entry.data_offset);
+    return 0;
+  }
+
+  int Parse() {
+    using namespace _graph_snapshot;
+    if (file_.size() < sizeof(Header)) {
+      return -2;
+    }
+    const Header& header = *reinterpret_cast<const Header*>(file_.data());
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0
+     || header.version != kVersion
+     || header.byte_order_mark != kByteOrderMark
+     || header.header_size != sizeof(Header)) {
+      return -2;
+    }
+    if (header.vertex_id_type    != TypeCode<VertexIDType>()
+     || header.vertex_label_type != TypeCode<VertexLabelType>()
+     || header.edge_id_type      != TypeCode<EdgeIDType>()
+     || header.edge_label_type   != TypeCode<EdgeLabelType>()) {
+      return -3;
+    }
+    if (!this->InFile(sizeof(Header),
+                      (uint64_t)header.section_num * sizeof(SectionEntry))) {
+      return -4;
+    }
+    const uint64_t kVertexNum = header.vertex_num,
+                     kEdgeNum = header.edge_num;
+    const SectionEntry* sections = reinterpret_cast<const SectionEntry*>(
+        file_.data() + sizeof(Header));
+
+    uint32_t structural_section_num = 0;
+    for (uint32_t i = 0; i < header.section_num; i++) {
+      const SectionEntry& section = sections[i];
+      bool res = true;
+      switch (static_cast<SectionKind>(section.kind)) {
+        case SectionKind::kVertexID:
+          res = this->SetArray(vertex_id_, section, kVertexNum);
+          break;
+        case SectionKind::kVertexLabel:
+          res = this->SetArray(vertex_label_, section, kVertexNum);
+          break;
+        case SectionKind::kVertexIDOrder:
+          res = this->SetArray(vertex_id_order_, section, kVertexNum);
+          break;
+        case SectionKind::kEdgeID:
+          res = this->SetArray(edge_id_, section, kEdgeNum);
+          break;
+        case SectionKind::kEdgeLabel:
+          res = this->SetArray(edge_label_, section, kEdgeNum);
+          break;
+        case SectionKind::kEdgeSrc:
+          res = this->SetArray(edge_src_, section, kEdgeNum);
+          break;
+        case SectionKind::kEdgeDst:
+          res = this->SetArray(edge_dst_, section, kEdgeNum);
+          break;
+        case SectionKind::kEdgeIDOrder:
+          res = this->SetArray(edge_id_order_, section, kEdgeNum);
+          break;
+        case SectionKind::kOutOffset:
+          res = this->SetArray(out_offset_, section, kVertexNum + 1);
+          break;
+        case SectionKind::kInOffset:
+          res = this->SetArray(in_offset_, section, kVertexNum + 1);
+          break;
+        case SectionKind::kInEdge:
+          res = this->SetArray(in_edge_, section, kEdgeNum);
+          break;
+        case SectionKind::kColumnTable: {
+          SnapshotArray<ColumnEntry> column_table;
+          res = this->SetArray(column_table, section,
+                               header.vertex_column_num
+                             + header.edge_column_num);
+          if (!res) {
+            break;
+          }
+          for (const auto& entry : column_table) {
+            int column_res
+                = entry.is_edge
+                ? this->AddColumn(entry, kEdgeNum,     edge_columns_)
+                : this->AddColumn(entry, kVertexNum, vertex_columns_);
+            if (column_res < 0) {
+              return column_res;
+            }
+          }
+          if (vertex_columns_.size() != header.vertex_column_num) {
+            return -4;
+          }
+          // not counted as a structural section
+          structural_section_num--;
+          break;
+        }
+        default:
+          // the sections of the column data are referred by
+          // the column table, unknown sections are skipped
+          structural_section_num--;
+          break;
+      }
+      if (!res) {
+        return -4;
+      }
+      structural_section_num++;
+    }
+    if (structural_section_num != kStructuralSectionNum) {
+      return -4;
+    }
+    vertex_num_ = kVertexNum;
+      edge_num_ =   kEdgeNum;
+    return 0;
+  }
+
+  _graph_snapshot::MappedFile file_;
+
+  size_t vertex_num_,
+           edge_num_;
+
+  SnapshotArray<VertexIDType>    vertex_id_;
+  SnapshotArray<VertexLabelType> vertex_label_;
+  SnapshotArray<uint64_t>        vertex_id_order_;
+
+  SnapshotArray<EdgeIDType>    edge_id_;
+  SnapshotArray<EdgeLabelType> edge_label_;
+  SnapshotArray<uint64_t>      edge_src_;
+  SnapshotArray<uint64_t>      edge_dst_;
+  SnapshotArray<uint64_t>      edge_id_order_;
+
+  SnapshotArray<uint64_t> out_offset_,
+                           in_offset_;
+  SnapshotArray<uint64_t>  in_edge_;
+
+  std::vector<VertexColumn> vertex_columns_;
+  std::vector<  EdgeColumn>   edge_columns_;
+};
+
+// the snapshot type to read the snapshot written from GraphType
+template <class GraphType>
+using GraphSnapshotOf
+    = GraphSnapshot<typename GraphType::VertexType::IDType,
+                    typename GraphType::VertexType::LabelType,
+                    typename GraphType::EdgeType::IDType,
+                    typename GraphType::EdgeType::LabelType,
+                    typename GraphType::VertexType::AttributeKeyType,
+                    typename GraphType::EdgeType::AttributeKeyType>;
+
+// write any graph type in GUNDAM to a snapshot file
+// returns the number of vertexes and edges written, or
+// a negative value if failed
+template <bool write_attr = true, class GraphType>
+int WriteGraphSnapshot(const GraphType& graph, const std::string& file) {
+  using namespace _graph_snapshot;
+
+  using VertexIDType    = typename GraphType::VertexType::IDType;
+  using VertexLabelType = typename GraphType::VertexType::LabelType;
+  using EdgeIDType      = typename GraphType::EdgeType::IDType;
+  using EdgeLabelType   = typename GraphType::EdgeType::LabelType;
+
+  using VertexHandleType = typename VertexHandle<const GraphType>::type;
+  using EdgeHandleType   = typename   EdgeHandle<const GraphType>::type;
+
+  // vertexes sorted by (label, id)
+  std::vector<VertexHandleType> vertex_handles;
+  vertex_handles.reserve(graph.CountVertex());
+  for (auto vertex_it = graph.VertexBegin();
+           !vertex_it.IsDone();
+            vertex_it++) {
+    vertex_handles.emplace_back(vertex_it);
+  }
+  std::sort(vertex_handles.begin(), vertex_handles.end(),
+            [](const VertexHandleType& a, const VertexHandleType& b) {
+              if (a->label() != b->label()) {
+                return a->label() < b->label();
+              }
+              return a->id() < b->id();
+            });
+  const uint64_t kVertexNum = vertex_handles.size();
+
+  std::vector<VertexIDType>    vertex_id;
+  std::vector<VertexLabelType> vertex_label;
+  std::vector<uint64_t>        vertex_id_order;
+  vertex_id.reserve(kVertexNum);
+  vertex_label.reserve(kVertexNum);
+  vertex_id_order.reserve(kVertexNum);
+  for (uint64_t i = 0; i < kVertexNum; i++) {
+    vertex_id.emplace_back(vertex_handles[i]->id());
+    vertex_label.emplace_back(vertex_handles[i]->label());
+    vertex_id_order.emplace_back(i);
+  }
+  std::sort(vertex_id_order.begin(), vertex_id_order.end(),
+            [&vertex_id](uint64_t a, uint64_t b) {
+              return vertex_id[a] < vertex_id[b];
+            });
+  auto vertex_idx_of = [&vertex_id, &vertex_id_order](const VertexIDType& id) {
+    auto it = std::lower_bound(vertex_id_order.begin(), vertex_id_order.end(),
+                               id, [&vertex_id](uint64_t idx,
+                                                const VertexIDType& id) {
+                                 return vertex_id[idx] < id;
+                               });
+    assert(it != vertex_id_order.end() && vertex_id[*it] == id);
+    return *it;
+  };
+
+  // edges sorted by (src, edge label, dst label, dst, id)
+  std::vector<std::tuple<uint64_t, uint64_t, EdgeHandleType>> edges;
+  edges.reserve(graph.CountEdge());
+  for (uint64_t src_idx = 0; src_idx < kVertexNum; src_idx++) {
+    for (auto edge_it = vertex_handles[src_idx]->OutEdgeBegin();
+             !edge_it.IsDone();
+              edge_it++) {
+      EdgeHandleType edge_handle = edge_it;
+      edges.emplace_back(src_idx, vertex_idx_of(edge_handle->dst_handle()->id()),
+                         edge_handle);
+    }
+  }
+  auto edge_less = [&vertex_label](uint64_t a_vertex, uint64_t a_adj,
+                                   const EdgeHandleType& a_edge,
+                                   uint64_t b_vertex, uint64_t b_adj,
+                                   const EdgeHandleType& b_edge) {
+    if (a_vertex != b_vertex) {
+      return a_vertex < b_vertex;
+    }
+    if (a_edge->label() != b_edge->label()) {
+      return a_edge->label() < b_edge->label();
+    }
+    if (vertex_label[a_adj] != vertex_label[b_adj]) {
+      return vertex_label[a_adj] < vertex_label[b_adj];
+    }
+    if (a_adj != b_adj) {
+      return a_adj < b_adj;
+    }
+    return a_edge->id() < b_edge->id();
+  };
+  std::sort(edges.begin(), edges.end(),
+            [&edge_less](const auto& a, const auto& b) {
+              return edge_less(std::get<0>(a), std::get<1>(a), std::get<2>(a),
+                               std::get<0>(b), std::get<1>(b), std::get<2>(b));
+            });
+  const uint64_t kEdgeNum = edges.size();
+
+  std::vector<EdgeIDType>    edge_id;
+  std::vector<EdgeLabelType> edge_label;
+  std::vector<uint64_t>      edge_src,
+                             edge_dst,
+                             edge_id_order,
+                             in_edge;
+  std::vector<uint64_t> out_offset(kVertexNum + 1, 0),
+                         in_offset(kVertexNum + 1, 0);
+  std::vector<EdgeHandleType> edge_handles;
+  edge_id.reserve(kEdgeNum);
+  edge_label.reserve(kEdgeNum);
+  edge_src.reserve(kEdgeNum);
+  edge_dst.reserve(kEdgeNum);
+  edge_id_order.reserve(kEdgeNum);
+  in_edge.reserve(kEdgeNum);
+  edge_handles.reserve(kEdgeNum);
+  for (uint64_t i = 0; i < kEdgeNum; i++) {
+    const auto& [src_idx, dst_idx, edge_handle] = edges[i];
+    edge_id.emplace_back(edge_handle->id());
+    edge_label.emplace_back(edge_handle->label());
+    edge_src.emplace_back(src_idx);
+    edge_dst.emplace_back(dst_idx);
+    edge_id_order.emplace_back(i);
+    in_edge.emplace_back(i);
+    edge_handles.emplace_back(edge_handle);
+    out_offset[src_idx + 1]++;
+     in_offset[dst_idx + 1]++;
+  }
+  decltype(edges)().swap(edges);
+  for (uint64_t i = 0; i < kVertexNum; i++) {
+    out_offset[i + 1] += out_offset[i];
+     in_offset[i + 1] +=  in_offset[i];
+  }
+  std::sort(edge_id_order.begin(), edge_id_order.end(),
+            [&edge_id](uint64_t a, uint64_t b) {
+              return edge_id[a] < edge_id[b];
+            });
+  std::sort(in_edge.begin(), in_edge.end(),
+            [&edge_less, &edge_src, &edge_dst, &edge_handles](uint64_t a,
+                                                              uint64_t b) {
+              return edge_less(edge_dst[a], edge_src[a], edge_handles[a],
+                               edge_dst[b], edge_src[b], edge_handles[b]);
+            });
+
+  // attribute columns, ordered by the key string
+  std::map<std::string, ColumnBuilder> vertex_columns,
+                                         edge_columns;
+  if constexpr (write_attr
+             && GraphParameter<GraphType>::vertex_has_attribute) {
+    if (!BuildColumns<false>(vertex_handles, vertex_columns)) {
+      return -1;
+    }
+  }
+  if constexpr (write_attr
+             && GraphParameter<GraphType>::edge_has_attribute) {
+    if (!BuildColumns<true>(edge_handles, edge_columns)) {
+      return -1;
+    }
+  }
+
+  // lay out the file
+  struct Block {
+    const void* data;
+    uint64_t size;
+    uint64_t offset;
+  };
+  std::vector<SectionEntry> sections;
+  std::vector<Block> blocks;
+  uint64_t offset = 0;
+  auto add_block = [&blocks, &offset](const void* data, uint64_t size) {
+    offset = AlignUp(offset);
+    blocks.push_back({data, size, offset});
+    offset += size;
+    return blocks.back().offset;
+  };
+  auto add_section = [&sections, &add_block](SectionKind kind,
+                                             const void* data,
+                                             uint64_t size) {
+    uint64_t section_offset = add_block(data, size);
+    sections.push_back({static_cast<uint32_t>(kind), 0,
+                        section_offset, size});
+    return;
+  };
+
+  const uint32_t kSectionNum = kStructuralSectionNum + 1
+                             + vertex_columns.size()
+                             + edge_columns.size();
+  offset = sizeof(Header) + kSectionNum * sizeof(SectionEntry);
+
+  add_section(SectionKind::kVertexID, vertex_id.data(),
+              kVertexNum * sizeof(VertexIDType));
+  add_section(SectionKind::kVertexLabel, vertex_label.data(),
+              kVertexNum * sizeof(VertexLabelType));
+  add_section(SectionKind::kVertexIDOrder, vertex_id_order.data(),
+              kVertexNum * sizeof(uint64_t));
+  add_section(SectionKind::kEdgeID, edge_id.data(),
+              kEdgeNum * sizeof(EdgeIDType));
+  add_section(SectionKind::kEdgeLabel, edge_label.data(),
+              kEdgeNum * sizeof(EdgeLabelType));
+  add_section(SectionKind::kEdgeSrc, edge_src.data(),
+              kEdgeNum * sizeof(uint64_t));
+  add_section(SectionKind::kEdgeDst, edge_dst.data(),
+              kEdgeNum * sizeof(uint64_t));
+  add_section(SectionKind::kEdgeIDOrder, edge_id_order.data(),
+              kEdgeNum * sizeof(uint64_t));
+  add_section(SectionKind::kOutOffset, out_offset.data(),
+              (kVertexNum + 1) * sizeof(uint64_t));
+  add_section(SectionKind::kInOffset, in_offset.data(),
+              (kVertexNum + 1) * sizeof(uint64_t));
+  add_section(SectionKind::kInEdge, in_edge.data(),
+              kEdgeNum * sizeof(uint64_t));
+
+  std::vector<ColumnEntry> column_table;
+  column_table.reserve(vertex_columns.size() + edge_columns.size());
+  // the column table is written before the column data, the
+  // offsets in it are filled after the data are laid out
+  add_section(SectionKind::kColumnTable, nullptr,
+              (vertex_columns.size() + edge_columns.size())
+                  * sizeof(ColumnEntry));
+  const size_t kColumnTableBlockIdx = blocks.size() - 1;
+  for (auto* columns : {&vertex_columns, &edge_columns}) {
+    for (const auto& [key, column] : *columns) {
+      ColumnEntry entry;
+      std::memset(&entry, 0, sizeof(ColumnEntry));
+      entry.is_edge = (columns == &edge_columns);
+      entry.value_type = static_cast<int32_t>(column.value_type());
+      const uint64_t kColumnBegin = AlignUp(offset);
+      entry.key_offset = add_block(key.data(), key.size());
+      entry.key_size   = key.size();
+      entry.null_offset = add_block(column.null_bitmap().data(),
+                                    column.null_bitmap().size()
+                                  * sizeof(uint64_t));
+      entry.value_offset = add_block(column.value_data(), column.value_size());
+      entry.value_size   = column.value_size();
+      entry.data_offset = add_block(column.data().data(),
+                                    column.data().size());
+      entry.data_size   = column.data().size();
+      sections.push_back({static_cast<uint32_t>(SectionKind::kColumnData), 0,
+                          kColumnBegin, offset - kColumnBegin});
+      column_table.emplace_back(entry);
+    }
+  }
+  blocks[kColumnTableBlockIdx].data = column_table.data();
+  assert(sections.size() == kSectionNum);
+
+  Header header;
+  std::memset(&header, 0, sizeof(Header));
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version           = kVersion;
+  header.byte_order_mark   = kByteOrderMark;
+  header.header_size       = sizeof(Header);
+  header.section_num       = kSectionNum;
+  header.vertex_id_type    = TypeCode<VertexIDType>();
+  header.vertex_label_type = TypeCode<VertexLabelType>();
+  header.edge_id_type      = TypeCode<EdgeIDType>();
+  header.edge_label_type   = TypeCode<EdgeLabelType>();
+  header.vertex_num        = kVertexNum;
+  header.edge_num          = kEdgeNum;
+  header.vertex_column_num = vertex_columns.size();
+  header.edge_column_num   = edge_columns.size();
+
+  std::ofstream out(file, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    std::cout << "cannot open file: " << file << std::endl;
+    return -1;
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  out.write(reinterpret_cast<const char*>(sections.data()),
+            sections.size() * sizeof(SectionEntry));
+  uint64_t written = sizeof(Header) + sections.size() * sizeof(SectionEntry);
+  const char kPadding[kAlignment] = {0};
+  for (const auto& block : blocks) {
+    assert(block.offset >= written && block.offset - written < kAlignment);
+    out.write(kPadding, block.offset - written);
+    out.write(static_cast<const char*>(block.data), block.size);
+    written = block.offset + block.size;
+  }
+  out.write(kPadding, AlignUp(written) - written);
+  if (!out) {
+    std::cout << "write snapshot failed: " << file << std::endl;
+    return -1;
+  }
+  return kVertexNum + kEdgeNum;
+}
+
+namespace _graph_snapshot {
+
+template <typename ElementHandle, typename ColumnType>
+inline bool AddColumnAttribute(ElementHandle& element_handle,
+                               const ColumnType& column, size_t idx) {
+  switch (column.value_type()) {
+    case BasicDataType::kTypeString:
+      return element_handle->AddAttribute(
+          column.key(), column.template value<std::string>(idx)).second;
+    case BasicDataType::kTypeInt:
+      return element_handle->AddAttribute(
+          column.key(), column.template value<int>(idx)).second;
+    case BasicDataType::kTypeInt64:
+      return element_handle->AddAttribute(
+          column.key(), column.template value<int64_t>(idx)).second;
+    case BasicDataType::kTypeFloat:
+      return element_handle->AddAttribute(
+          column.key(), column.template value<float>(idx)).second;
+    case BasicDataType::kTypeDouble:
+      return element_handle->AddAttribute(
+          column.key(), column.template value<double>(idx)).second;
+    case BasicDataType::kTypeDateTime:
+      return element_handle->AddAttribute(
+          column.key(), column.template value<DateTime>(idx)).second;
+    case BasicDataType::kTypeBool:
+      return element_handle->AddAttribute(
+          column.key(), column.template value<bool>(idx)).second;
+    case BasicDataType::kTypeChar:
+      return element_handle->AddAttribute(
+          column.key(), column.template value<char>(idx)).second;
+    default:
+      return false;
+  }
+}
+
+template <bool is_edge, typename ElementHandle, typename ColumnType>
+inline int AddAllColumnAttributes(ElementHandle& element_handle,
+                                  const std::vector<ColumnType>& columns,
+                                  size_t idx) {
+  for (const auto& column : columns) {
+    if (column.IsNull(idx)) {
+      continue;
+    }
+    if (!AddColumnAttribute(element_handle, column, idx)) {
+      std::cout << "add " << (is_edge ? "edge" : "vertex")
+                << " attribute failed, key: " << column.key() << std::endl;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+}  // namespace _graph_snapshot
+
+// load the whole snapshot into a graph, the vertexes and edges are
+// added one-by-one as ReadCSVGraph does
+// returns the number of vertexes and edges read, or a negative
+// value if failed
+template <bool read_vertex_attr = true,
+          bool read_edge_attr   = true, class GraphType>
+int ReadGraphSnapshot(GraphType& graph,
+                      const GraphSnapshotOf<GraphType>& snapshot) {
+  using namespace _graph_snapshot;
+  assert(snapshot.IsOpen());
+  for (size_t i = 0; i < snapshot.CountVertex(); i++) {
+    auto [vertex_handle, ret] = graph.AddVertex(snapshot.vertex_id()[i],
+                                                snapshot.vertex_label()[i]);
+    if (!ret) {
+      std::cout << "add vertex failed, id: " << snapshot.vertex_id()[i]
+                << std::endl;
+      return -1;
+    }
+    if constexpr (read_vertex_attr
+               && GraphParameter<GraphType>::vertex_has_attribute) {
+      if (AddAllColumnAttributes<false>(vertex_handle,
+                                        snapshot.vertex_columns(), i) < 0) {
+        return -1;
+      }
+    }
+  }
+  for (size_t i = 0; i < snapshot.CountEdge(); i++) {
+    auto [edge_handle, ret] = graph.AddEdge(
+        snapshot.vertex_id()[snapshot.edge_src()[i]],
+        snapshot.vertex_id()[snapshot.edge_dst()[i]],
+        snapshot.edge_label()[i],
+        snapshot.edge_id()[i]);
+    if (!ret) {
+      std::cout << "add edge failed, id: " << snapshot.edge_id()[i]
+                << std::endl;
+      return -1;
+    }
+    if constexpr (read_edge_attr
+               && GraphParameter<GraphType>::edge_has_attribute) {
+      if (AddAllColumnAttributes<true>(edge_handle,
+                                       snapshot.edge_columns(), i) < 0) {
+        return -1;
+      }
+    }
+  }
+  std::cout << " Vertex: " << snapshot.CountVertex() << std::endl;
+  std::cout << "   Edge: " << snapshot.CountEdge() << std::endl;
+  return snapshot.CountVertex() + snapshot.CountEdge();
+}
+
+// the snapshot has already been in the order held in CSRGraph, the
+// structure is built from the arrays without sorting or looking up
+template <bool read_vertex_attr = true,
+          bool read_edge_attr   = true,
+          class VertexIDType, class VertexLabelType,
+          class EdgeIDType,   class EdgeLabelType,
+          class VertexAttributeKeyType,
+          class   EdgeAttributeKeyType>
+int ReadGraphSnapshot(CSRGraph<VertexIDType, VertexLabelType,
+                               VertexAttributeKeyType,
+                               EdgeIDType,   EdgeLabelType,
+                               EdgeAttributeKeyType>& graph,
+                      const GraphSnapshot<VertexIDType, VertexLabelType,
+                                          EdgeIDType,   EdgeLabelType,
+                                          VertexAttributeKeyType,
+                                          EdgeAttributeKeyType>& snapshot) {
+  using namespace _graph_snapshot;
+  using GraphType = CSRGraph<VertexIDType, VertexLabelType,
+                             VertexAttributeKeyType,
+                             EdgeIDType,   EdgeLabelType,
+                             EdgeAttributeKeyType>;
+  assert(snapshot.IsOpen());
+  graph.BuildSorted(snapshot.CountVertex(),
+                    snapshot.vertex_id().data(),
+                    snapshot.vertex_label().data(),
+                    snapshot.vertex_id_order().data(),
+                    snapshot.CountEdge(),
+                    snapshot.edge_id().data(),
+                    snapshot.edge_label().data(),
+                    snapshot.edge_src().data(),
+                    snapshot.edge_dst().data(),
+                    snapshot.edge_id_order().data(),
+                    snapshot.in_edge().data());
+  if constexpr (read_vertex_attr) {
+    if (!snapshot.vertex_columns().empty()) {
+      size_t idx = 0;
+      for (auto vertex_it = graph.VertexBegin();
+               !vertex_it.IsDone();
+                vertex_it++, idx++) {
+        typename VertexHandle<GraphType>::type vertex_handle = vertex_it;
+        if (AddAllColumnAttributes<false>(vertex_handle,
+                                          snapshot.vertex_columns(),
+                                          idx) < 0) {
+          return -1;
+        }
+      }
+    }
+  }
+  if constexpr (read_edge_attr) {
+    if (!snapshot.edge_columns().empty()) {
+      size_t idx = 0;
+      for (auto edge_it = graph.EdgeBegin();
+               !edge_it.IsDone();
+                edge_it++, idx++) {
+        typename EdgeHandle<GraphType>::type edge_handle = edge_it;
+        if (AddAllColumnAttributes<true>(edge_handle,
+                                         snapshot.edge_columns(),
+                                         idx) < 0) {
+          return -1;
+        }
+      }
+    }
+  }
+  std::cout << " Vertex: " << snapshot.CountVertex() << std::endl;
+  std::cout << "   Edge: " << snapshot.CountEdge() << std::endl;
+  return snapshot.CountVertex() + snapshot.CountEdge();
+}
+
+template <bool read_vertex_attr = true,
+          bool read_edge_attr   = true, class GraphType>
+int ReadGraphSnapshot(GraphType& graph, const std::string& file) {
+  GraphSnapshotOf<GraphType> snapshot;
+  int res = snapshot.Open(file);
+  if (res < 0) {
+    return res;
+  }
+  return ReadGraphSnapshot<read_vertex_attr,
+                           read_edge_attr>(graph, snapshot);
+}
+
+}  // namespace GUNDAM
+
+#endif  // _GUNDAM_IO_GRAPH_SNAPSHOT_H
@@ -158,6 +158,100 @@ TEST(TestGUNDAM, TestAttribute) {
   return;
 }
 
+TEST(TestGUNDAM, TestColumnarAttribute) {
+  using namespace GUNDAM;
+
+  using AttributeType4 =
+        Attribute_<AttributeType::kColumnar,
+                   false, int32_t,
+                   std::string,
+                   ContainerType::Vector,
+                        SortType::Default>;
+
+  auto attr1_ptr = new AttributeType4(1), // slot 0
+       attr2_ptr = new AttributeType4(1), // slot 1
+       attr3_ptr = new AttributeType4(1); // slot 2
+
+  TestAttribute(attr1_ptr);
+  TestAttribute(attr2_ptr);
+  TestAttribute(attr3_ptr);
+  delete attr2_ptr;
+  // slot 1, the values of the released one are erased
+  attr2_ptr = new AttributeType4(1);
+  ASSERT_EQ(attr2_ptr->slot(), 1);
+  ASSERT_TRUE(attr2_ptr->AttributeBegin().IsDone());
+  TestAttribute(attr2_ptr);
+
+  // another group
+  AttributeType4 attr4(2);
+  ASSERT_EQ(attr4.slot(), 0);
+  ASSERT_TRUE(attr4.AttributeBegin().IsDone());
+  ASSERT_FALSE(attr4.FindColumn<int>("a"));
+
+  auto column_a = attr1_ptr->FindColumn<int>("a");
+  ASSERT_TRUE(column_a);
+  ASSERT_FALSE(attr1_ptr->FindColumn<int64_t>("a"));
+  ASSERT_EQ(column_a, attr3_ptr->FindColumn<int>("a"));
+  ASSERT_EQ(column_a->Count(), 3);
+  attr3_ptr->attribute(column_a) = 5;
+  ASSERT_EQ(attr3_ptr->const_attribute(column_a), 5);
+  ASSERT_EQ(attr3_ptr->const_attribute<int>("a"), 5);
+
+  // change the value type
+  auto ret = attr2_ptr->SetAttribute("a", (int64_t)7);
+  ASSERT_TRUE(ret.second);
+  ASSERT_EQ(ret.first->value_type(), BasicDataType::kTypeInt64);
+  ASSERT_EQ(ret.first->value_str(), "7");
+  ASSERT_FALSE(attr2_ptr->HasAttribute(column_a));
+  ASSERT_EQ(column_a->Count(), 2);
+  ASSERT_EQ(attr2_ptr->attribute_value_type("a"), BasicDataType::kTypeInt64);
+
+  std::vector<std::pair<size_t, int>> visited;
+  column_a->ForEach([&visited](size_t slot, int value) {
+    visited.emplace_back(slot, value);
+  });
+  ASSERT_EQ(visited.size(), 2);
+  ASSERT_EQ(visited[0], std::make_pair((size_t)0, 2));
+  ASSERT_EQ(visited[1], std::make_pair((size_t)2, 5));
+
+  auto selected = column_a->Select([](int value) { return value > 3; });
+  ASSERT_EQ(selected.size(), 1);
+  ASSERT_EQ(selected[0], (uint64_t)1 << 2);
+
+  // the same strings share one entry of the dictionary
+  auto column_b = attr1_ptr->FindColumn<std::string>("b");
+  ASSERT_TRUE(column_b);
+  ASSERT_EQ(column_b->Count(), 3);
+  attr1_ptr->attribute<std::string>("b") = "DEF";
+  ASSERT_EQ(attr1_ptr->const_attribute<std::string>("b"), "DEF");
+  ASSERT_EQ(attr2_ptr->const_attribute<std::string>("b"), "ABC");
+  ASSERT_EQ(attr3_ptr->const_attribute<std::string>("b"), "ABC");
+  ASSERT_TRUE(attr3_ptr->SetAttribute("b", std::string("DEF")).second);
+  ASSERT_EQ(attr3_ptr->const_attribute<std::string>("b"), "DEF");
+  ASSERT_EQ(attr1_ptr->const_attribute<std::string>("b"), "DEF");
+  selected = column_b->Select([](const std::string& value) {
+    return value == "DEF";
+  });
+  ASSERT_EQ(selected[0], ((uint64_t)1 << 0) | ((uint64_t)1 << 2));
+
+  ASSERT_EQ(attr1_ptr->EraseAttribute("b"), 1);
+  ASSERT_EQ(attr1_ptr->EraseAttribute("b"), 0);
+  ASSERT_FALSE(attr1_ptr->FindAttribute("b"));
+  ASSERT_EQ(column_b->Count(), 2);
+
+  int count = 0;
+  for (auto it = attr1_ptr->AttributeBegin(); !it.IsDone();) {
+    it = attr1_ptr->EraseAttribute(it);
+    count++;
+  }
+  ASSERT_EQ(count, 8);
+  ASSERT_TRUE(attr1_ptr->AttributeBegin().IsDone());
+
+  delete attr1_ptr;
+  delete attr2_ptr;
+  delete attr3_ptr;
+}
+
 template <typename GraphType>
 void TestGraphAttribute() {
   using namespace GUNDAM;       
@@ -325,12 +419,22 @@ TEST(TestGUNDAM, TestGraphAttribute) {
                    SetEdgeAttributeKeyType<std::string>,
                    SetEdgeAttributeStoreType<AttributeType::kGrouped>>;
 
+  using G7 = Graph<SetVertexIDType<uint32_t>, 
+                   SetVertexLabelType<std::string>,
+                   SetVertexAttributeKeyType<std::string>, 
+                   SetVertexAttributeStoreType<AttributeType::kColumnar>,
+                   SetEdgeIDType<uint64_t>,
+                   SetEdgeLabelType<std::string>, 
+                   SetEdgeAttributeKeyType<std::string>,
+                   SetEdgeAttributeStoreType<AttributeType::kColumnar>>;
+
   TestGraphAttribute<G1>();
   TestGraphAttribute<G2>();
   TestGraphAttribute<G3>();
   TestGraphAttribute<G4>();
   TestGraphAttribute<G5>();
   TestGraphAttribute<G6>();
+  TestGraphAttribute<G7>();
 
   TestGraphAttribute<GraphBase<G1>>();
   TestGraphAttribute<GraphBase<G2>>();
@@ -338,4 +442,5 @@ TEST(TestGUNDAM, TestGraphAttribute) {
   TestGraphAttribute<GraphBase<G4>>();
   TestGraphAttribute<GraphBase<G5>>();
   TestGraphAttribute<GraphBase<G6>>();
+  TestGraphAttribute<GraphBase<G7>>();
 }
\ No newline at end of file
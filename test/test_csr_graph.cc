@@ -0,0 +1,229 @@
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "gundam/graph_type/csr_graph.h"
+#include "gundam/graph_type/graph.h"
+#include "gundam/graph_type/large_graph.h"
+#include "gundam/graph_type/large_graph2.h"
+
+#include "gundam/algorithm/dp_iso.h"
+#include "gundam/algorithm/vf2.h"
+#include "gundam/algorithm/simulation.h"
+
+#include "gundam/type_getter/vertex_handle.h"
+#include "gundam/type_getter/edge_handle.h"
+
+template <class GraphType>
+void BuildTestGraph(GraphType& g) {
+  using VertexLabelType = typename GraphType::VertexType::LabelType;
+  using   EdgeLabelType = typename GraphType::  EdgeType::LabelType;
+
+  g.AddVertex(1, VertexLabelType(0));
+  g.AddVertex(2, VertexLabelType(1));
+  g.AddVertex(3, VertexLabelType(0));
+  g.AddVertex(4, VertexLabelType(1));
+  g.AddVertex(5, VertexLabelType(2));
+
+  g.AddEdge(1, 2, EdgeLabelType(1), 1);
+  g.AddEdge(3, 2, EdgeLabelType(1), 2);
+  g.AddEdge(3, 1, EdgeLabelType(1), 3);
+  g.AddEdge(1, 4, EdgeLabelType(2), 4);
+  g.AddEdge(1, 2, EdgeLabelType(2), 5);
+  g.AddEdge(4, 5, EdgeLabelType(1), 6);
+  g.AddEdge(1, 2, EdgeLabelType(1), 7);
+  return;
+}
+
+template <class SrcGraphType, class CSRGraphType>
+void TestCSRGraphBuild() {
+  using namespace GUNDAM;
+
+  SrcGraphType src_graph;
+  BuildTestGraph(src_graph);
+
+  CSRGraphType csr_graph(src_graph);
+  const CSRGraphType& const_csr_graph = csr_graph;
+
+  ASSERT_EQ(csr_graph.CountVertex(), src_graph.CountVertex());
+  ASSERT_EQ(csr_graph.CountEdge(),   src_graph.CountEdge());
+  ASSERT_EQ(csr_graph.CountVertex(0), 2);
+  ASSERT_EQ(csr_graph.CountVertex(1), 2);
+  ASSERT_EQ(csr_graph.CountVertex(2), 1);
+  ASSERT_EQ(csr_graph.CountVertex(3), 0);
+
+  size_t vertex_counter = 0;
+  for (auto vertex_it = csr_graph.VertexBegin();
+           !vertex_it.IsDone();
+            vertex_it++) {
+    auto src_vertex_handle = src_graph.FindVertex(vertex_it->id());
+    ASSERT_TRUE(src_vertex_handle);
+    ASSERT_EQ(vertex_it->label(),         src_vertex_handle->label());
+    ASSERT_EQ(vertex_it->CountOutEdge(),  src_vertex_handle->CountOutEdge());
+    ASSERT_EQ(vertex_it->CountInEdge(),   src_vertex_handle->CountInEdge());
+    ASSERT_EQ(vertex_it->CountOutVertex(), src_vertex_handle->CountOutVertex());
+    ASSERT_EQ(vertex_it->CountInVertex(),  src_vertex_handle->CountInVertex());
+    vertex_counter++;
+  }
+  ASSERT_EQ(vertex_counter, csr_graph.CountVertex());
+
+  for (auto vertex_it = csr_graph.VertexBegin(1);
+           !vertex_it.IsDone();
+            vertex_it++) {
+    ASSERT_EQ(vertex_it->label(), 1);
+  }
+
+  auto vertex_handle_1 = csr_graph.FindVertex(1);
+  auto vertex_handle_2 = csr_graph.FindVertex(2);
+  ASSERT_TRUE(vertex_handle_1);
+  ASSERT_TRUE(vertex_handle_2);
+  ASSERT_FALSE(csr_graph.FindVertex(6));
+  ASSERT_EQ(vertex_handle_1->CountOutEdge(),  4);
+  ASSERT_EQ(vertex_handle_1->CountOutVertex(), 2);
+  ASSERT_EQ(vertex_handle_1->CountOutEdge(1), 2);
+  ASSERT_EQ(vertex_handle_1->CountOutEdge(2), 2);
+  ASSERT_EQ(vertex_handle_1->CountOutEdge(3), 0);
+  ASSERT_EQ(vertex_handle_1->CountOutVertex(2), 2);
+  ASSERT_EQ(vertex_handle_1->CountOutEdge(1, vertex_handle_2), 2);
+  ASSERT_EQ(vertex_handle_2-> CountInEdge(1, vertex_handle_1), 2);
+  ASSERT_EQ(vertex_handle_2-> CountInEdge(1), 3);
+  ASSERT_EQ(vertex_handle_2-> CountInVertex(1), 2);
+
+  // edges in each label group are sorted by adjacent vertex label
+  for (auto edge_label_it = vertex_handle_1->OutEdgeLabelBegin();
+           !edge_label_it.IsDone();
+            edge_label_it++) {
+    typename CSRGraphType::VertexType::LabelType last_label = 0;
+    for (auto edge_it = vertex_handle_1->OutEdgeBegin(*edge_label_it);
+             !edge_it.IsDone();
+              edge_it++) {
+      ASSERT_EQ(edge_it->label(), *edge_label_it);
+      ASSERT_LE(last_label, edge_it->dst_handle()->label());
+      last_label = edge_it->dst_handle()->label();
+    }
+  }
+
+  std::set<typename CSRGraphType::EdgeType::IDType> edge_id_set;
+  for (auto edge_it = const_csr_graph.EdgeBegin();
+           !edge_it.IsDone();
+            edge_it++) {
+    auto src_edge_handle = src_graph.FindEdge(edge_it->id());
+    ASSERT_TRUE(src_edge_handle);
+    ASSERT_EQ(edge_it->src_handle()->id(), src_edge_handle->src_handle()->id());
+    ASSERT_EQ(edge_it->dst_handle()->id(), src_edge_handle->dst_handle()->id());
+    ASSERT_EQ(edge_it->label(), src_edge_handle->label());
+    ASSERT_TRUE(edge_id_set.emplace(edge_it->id()).second);
+  }
+  ASSERT_EQ(edge_id_set.size(), csr_graph.CountEdge());
+  ASSERT_TRUE(const_csr_graph.FindEdge(7));
+  ASSERT_FALSE(const_csr_graph.FindEdge(8));
+
+  CSRGraphType csr_graph_copy(csr_graph);
+  ASSERT_EQ(csr_graph_copy.CountVertex(), csr_graph.CountVertex());
+  ASSERT_EQ(csr_graph_copy.CountEdge(),   csr_graph.CountEdge());
+  ASSERT_NE(csr_graph_copy.FindVertex(1), csr_graph.FindVertex(1));
+  return;
+}
+
+template <class CSRGraphType>
+void TestCSRGraphAttribute() {
+  using namespace GUNDAM;
+
+  using LG = LargeGraph<uint32_t, uint32_t, std::string,
+                        uint32_t, uint32_t, std::string>;
+
+  LG src_graph;
+  BuildTestGraph(src_graph);
+  src_graph.FindVertex(1)->AddAttribute(std::string("name"), std::string("a"));
+  src_graph.FindEdge(4)->AddAttribute(std::string("weight"), int(4));
+
+  CSRGraphType csr_graph(src_graph);
+  auto vertex_handle = csr_graph.FindVertex(1);
+  ASSERT_TRUE(vertex_handle);
+  auto vertex_attr_handle = vertex_handle->FindAttribute(std::string("name"));
+  ASSERT_TRUE(vertex_attr_handle);
+  ASSERT_EQ(vertex_attr_handle->template const_value<std::string>(), "a");
+
+  auto edge_handle = csr_graph.FindEdge(4);
+  ASSERT_TRUE(edge_handle);
+  auto edge_attr_handle = edge_handle->FindAttribute(std::string("weight"));
+  ASSERT_TRUE(edge_attr_handle);
+  ASSERT_EQ(edge_attr_handle->template const_value<int>(), 4);
+  ASSERT_TRUE(edge_handle->SetAttribute(std::string("weight"), int(5)).second);
+  ASSERT_EQ(edge_handle->FindAttribute(std::string("weight"))
+                       ->template const_value<int>(), 5);
+  return;
+}
+
+template <class QueryGraph, class TargetGraph>
+void TestCSRGraphMatch() {
+  using namespace GUNDAM;
+
+  using VertexLabelType = typename QueryGraph::VertexType::LabelType;
+  using   EdgeLabelType = typename QueryGraph::  EdgeType::LabelType;
+
+  using  QueryVertexHandle = typename VertexHandle< QueryGraph>::type;
+  using TargetVertexHandle = typename VertexHandle<TargetGraph>::type;
+
+  QueryGraph query;
+  query.AddVertex(1, VertexLabelType(0));
+  query.AddVertex(2, VertexLabelType(1));
+  query.AddVertex(3, VertexLabelType(0));
+  query.AddEdge(1, 2, EdgeLabelType(1), 1);
+  query.AddEdge(3, 2, EdgeLabelType(1), 2);
+
+  LargeGraph<uint32_t, uint32_t, std::string,
+             uint32_t, uint32_t, std::string> src_target;
+  BuildTestGraph(src_target);
+  TargetGraph target(src_target);
+
+  std::vector<std::map<QueryVertexHandle,
+                      TargetVertexHandle>> match_result;
+  int dp_iso_count = DPISO<MatchSemantics::kIsomorphism>(
+                           query, target, -1, match_result);
+  ASSERT_EQ(dp_iso_count, 2);
+
+  std::vector<std::map<QueryVertexHandle,
+                      TargetVertexHandle>> vf2_match_result;
+  int vf2_count = VF2<MatchSemantics::kIsomorphism>(
+                      query, target, -1, vf2_match_result);
+  ASSERT_EQ(vf2_count, dp_iso_count);
+
+  std::map<QueryVertexHandle,
+           std::vector<TargetVertexHandle>> simulation_match_set;
+  ASSERT_GT(Simulation<MatchSemantics::kDualSimulation>(
+                       query, target, simulation_match_set), 0);
+  return;
+}
+
+TEST(TestGUNDAM, TestCSRGraph) {
+  using namespace GUNDAM;
+
+  using G1 = Graph<SetVertexIDType<uint32_t>, SetVertexLabelType<uint32_t>,
+                   SetVertexAttributeKeyType<std::string>,
+                   SetEdgeIDType<uint32_t>, SetEdgeLabelType<uint32_t>,
+                   SetEdgeAttributeKeyType<std::string>>;
+
+  using LG = LargeGraph<uint32_t, uint32_t, std::string,
+                        uint32_t, uint32_t, std::string>;
+
+  using LG2 = LargeGraph2<uint32_t, uint32_t, std::string,
+                          uint32_t, uint32_t, std::string>;
+
+  using CSRG = CSRGraph<uint32_t, uint32_t, std::string,
+                        uint32_t, uint32_t, std::string>;
+
+  TestCSRGraphBuild<G1 , CSRG>();
+  TestCSRGraphBuild<LG , CSRG>();
+  TestCSRGraphBuild<LG2, CSRG>();
+
+  TestCSRGraphAttribute<CSRG>();
+
+  TestCSRGraphMatch<G1, CSRG>();
+  TestCSRGraphMatch<LG, CSRG>();
+}
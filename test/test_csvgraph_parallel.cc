@@ -0,0 +1,405 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "gundam/graph_type/graph.h"
+#include "gundam/graph_type/large_graph.h"
+#include "gundam/graph_type/large_graph2.h"
+#include "gundam/io/csvgraph.h"
+#include "gundam/io/csvgraph_parallel.h"
+
+#include "gundam/type_getter/vertex_handle.h"
+#include "gundam/type_getter/edge_handle.h"
+
+void WriteTestCSVGraph(const std::string& v_file,
+                       const std::string& e_file,
+                       int vertex_num, int edge_num) {
+  std::mt19937 gen(20211018);
+  std::ofstream v_out(v_file);
+  v_out << "vertex_id:int64,label_id:int,name:string,age:int,"
+           "score:double,time:datetime" << std::endl;
+  for (int vertex_id = 1; vertex_id <= vertex_num; vertex_id++) {
+    v_out << vertex_id << "," << gen() % 5 << ",";
+    if (vertex_id % 2 == 0) {
+      v_out << "v" << vertex_id;
+    }
+    v_out << ",";
+    if (vertex_id % 3 == 0) {
+      v_out << vertex_id * 7;
+    }
+    v_out << "," << vertex_id * 0.25 << ",";
+    if (vertex_id % 5 == 0) {
+      v_out << "2021-10-18 12:00:" << (vertex_id % 60 < 10 ? "0" : "")
+            << vertex_id % 60;
+    }
+    // windows line breaks are also accepted
+    v_out << (vertex_id % 7 == 0 ? "\r\n" : "\n");
+  }
+  std::ofstream e_out(e_file);
+  e_out << "edge_id:int64,source_id:int64,target_id:int64,label_id:int,"
+           "weight:int64" << std::endl;
+  for (int edge_id = 1; edge_id <= edge_num; edge_id++) {
+    e_out << edge_id << "," << gen() % vertex_num + 1 << ","
+          << gen() % vertex_num + 1 << "," << gen() % 3 << ",";
+    if (edge_id % 4 == 0) {
+      e_out << (int64_t)edge_id * 1000000007;
+    }
+    e_out << std::endl;
+  }
+  return;
+}
+
+template <class GraphType>
+void CheckSameCSVGraph(GraphType& g1, GraphType& g2) {
+  ASSERT_EQ(g1.CountVertex(), g2.CountVertex());
+  ASSERT_EQ(g1.CountEdge(),   g2.CountEdge());
+  for (auto vertex_it = g1.VertexBegin(); !vertex_it.IsDone(); vertex_it++) {
+    auto vertex_handle = g2.FindVertex(vertex_it->id());
+    ASSERT_TRUE(vertex_handle);
+    ASSERT_EQ(vertex_handle->label(), vertex_it->label());
+    size_t attr_count = 0;
+    for (auto attr_it = vertex_it->AttributeBegin();
+             !attr_it.IsDone();
+              attr_it++) {
+      auto attr_handle = vertex_handle->FindAttribute(attr_it->key());
+      ASSERT_TRUE(attr_handle);
+      ASSERT_EQ(attr_handle->value_type(), attr_it->value_type());
+      ASSERT_EQ(attr_handle->value_str(),  attr_it->value_str());
+      attr_count++;
+    }
+    for (auto attr_it = vertex_handle->AttributeBegin();
+             !attr_it.IsDone();
+              attr_it++) {
+      attr_count--;
+    }
+    ASSERT_EQ(attr_count, 0);
+    for (auto edge_it = vertex_it->OutEdgeBegin();
+             !edge_it.IsDone();
+              edge_it++) {
+      auto edge_handle = g2.FindEdge(edge_it->id());
+      ASSERT_TRUE(edge_handle);
+      ASSERT_EQ(edge_handle->label(), edge_it->label());
+      ASSERT_EQ(edge_handle->src_handle()->id(), edge_it->src_handle()->id());
+      ASSERT_EQ(edge_handle->dst_handle()->id(), edge_it->dst_handle()->id());
+      auto attr_handle = edge_it->FindAttribute(std::string("weight"));
+      auto other_attr_handle = edge_handle->FindAttribute(std::string("weight"));
+      ASSERT_EQ((bool)attr_handle, (bool)other_attr_handle);
+      if (attr_handle) {
+        ASSERT_EQ(attr_handle->template const_value<int64_t>(),
+                  other_attr_handle->template const_value<int64_t>());
+      }
+    }
+  }
+  return;
+}
+
+template <class GraphType>
+void TestReadCSVGraphParallel() {
+  using namespace GUNDAM;
+
+  const std::string v_file = "test_csvgraph_parallel_v.csv",
+                    e_file = "test_csvgraph_parallel_e.csv";
+  WriteTestCSVGraph(v_file, e_file, 1000, 5000);
+
+  GraphType g0;
+  int res = ReadCSVGraph(g0, v_file, e_file);
+  ASSERT_EQ(res, 6000);
+
+  for (int thread_num : {1, 2, 4, 8}) {
+    // small chunks to split the lines across chunks
+    for (size_t chunk_size : {(size_t)100, (size_t)4096,
+                              _csv_parallel::kDefaultChunkSize}) {
+      GraphType g1;
+      res = ReadCSVGraphParallel(g1, v_file, e_file, thread_num, chunk_size);
+      ASSERT_EQ(res, 6000);
+      CheckSameCSVGraph(g0, g1);
+      CheckSameCSVGraph(g1, g0);
+    }
+  }
+
+  // without attributes
+  GraphType g2;
+  res = ReadCSVGraphParallel<false, false>(g2, v_file, e_file, 4);
+  ASSERT_EQ(res, 6000);
+  for (auto vertex_it = g2.VertexBegin(); !vertex_it.IsDone(); vertex_it++) {
+    ASSERT_TRUE(vertex_it->AttributeBegin().IsDone());
+  }
+
+  std::remove(v_file.c_str());
+  std::remove(e_file.c_str());
+  return;
+}
+
+template <class GraphType>
+void TestReadCSVGraphParallelFormat() {
+  using namespace GUNDAM;
+
+  const std::string v_file = "test_csvgraph_parallel_format_v.csv",
+                    e_file = "test_csvgraph_parallel_format_e.csv";
+  {
+    std::ofstream v_out(v_file);
+    v_out << "vertex_id:int64,label_id:int,name:string,age:int\n"
+          << "1,0,\"a,b\",3\n"
+          << "2,1,\"say \"\"hi\"\"\",\n"
+          << "\n"
+          << "3,0\n"
+          // duplicated vertex
+          << "3,1,c,4\n"
+          // not a number
+          << "x,1,d,5\n"
+          << "4,1,e,not_a_number\n"
+          // without line break at the end of the file
+          << "5,2,f,6";
+    std::ofstream e_out(e_file);
+    e_out << "edge_id:int64,source_id:int64,target_id:int64,label_id:int\n"
+          << "1,1,2,0\n"
+          << "2,2,3,0\n"
+          // not existing vertex
+          << "3,2,4,0\n"
+          << "4,5,1,1\n";
+  }
+
+  GraphType g;
+  int res = ReadCSVGraphParallel(g, v_file, e_file, 4, 8);
+  ASSERT_EQ(res, 7);
+  ASSERT_EQ(g.CountVertex(), 4);
+  ASSERT_EQ(g.CountEdge(), 3);
+
+  auto vertex_handle = g.FindVertex(1);
+  ASSERT_TRUE(vertex_handle);
+  ASSERT_EQ(vertex_handle->FindAttribute(std::string("name"))
+                         ->template const_value<std::string>(), "a,b");
+  ASSERT_EQ(vertex_handle->FindAttribute(std::string("age"))
+                         ->template const_value<int>(), 3);
+
+  vertex_handle = g.FindVertex(2);
+  ASSERT_TRUE(vertex_handle);
+  ASSERT_EQ(vertex_handle->FindAttribute(std::string("name"))
+                         ->template const_value<std::string>(),
+            "say \"hi\"");
+  ASSERT_FALSE(vertex_handle->FindAttribute(std::string("age")));
+
+  vertex_handle = g.FindVertex(3);
+  ASSERT_TRUE(vertex_handle);
+  ASSERT_EQ(vertex_handle->label(), 0);
+  ASSERT_TRUE(vertex_handle->AttributeBegin().IsDone());
+
+  ASSERT_FALSE(g.FindVertex(4));
+
+  vertex_handle = g.FindVertex(5);
+  ASSERT_TRUE(vertex_handle);
+  ASSERT_EQ(vertex_handle->FindAttribute(std::string("age"))
+                         ->template const_value<int>(), 6);
+
+  // wrong header
+  {
+    std::ofstream v_out(v_file);
+    v_out << "id:int64,label_id:int\n"
+          << "1,0\n";
+  }
+  GraphType g1;
+  ASSERT_LT(ReadCSVGraphParallel(g1, v_file, e_file, 4), 0);
+  ASSERT_LT(ReadCSVGraphParallel(g1, "not_exist.csv", e_file, 4), 0);
+
+  std::remove(v_file.c_str());
+  std::remove(e_file.c_str());
+  return;
+}
+
+template <class GraphType>
+void TestAddBatch() {
+  GraphType g;
+  ASSERT_TRUE(g.AddVertex(5, 0).second);
+
+  // unsorted, duplicated in the batch and already in the graph
+  auto vertex_ret = g.AddVertexBatch({{3, 1}, {1, 0}, {5, 1},
+                                      {2, 1}, {3, 0}, {4, 2}});
+  ASSERT_EQ(vertex_ret.size(), 6);
+  std::vector<bool> vertex_added = {true, true, false, true, false, true};
+  for (size_t idx = 0; idx < vertex_ret.size(); idx++) {
+    ASSERT_EQ(vertex_ret[idx].second, vertex_added[idx]);
+    ASSERT_TRUE(vertex_ret[idx].first);
+  }
+  ASSERT_EQ(vertex_ret[2].first, g.FindVertex(5));
+  ASSERT_EQ(vertex_ret[4].first, vertex_ret[0].first);
+  ASSERT_EQ(g.CountVertex(), 5);
+  ASSERT_EQ(g.FindVertex(3)->label(), 1);
+  ASSERT_EQ(g.FindVertex(5)->label(), 0);
+  ASSERT_EQ(g.CountVertex(1), 2);
+
+  ASSERT_TRUE(g.AddEdge(1, 2, 0, 10).second);
+  auto edge_ret = g.AddEdgeBatch({{2, 3, 1, 12}, {1, 6, 0, 13},
+                                  {3, 4, 0, 11}, {4, 5, 0, 10},
+                                  {5, 1, 2, 12}, {5, 1, 2, 14}});
+  ASSERT_EQ(edge_ret.size(), 6);
+  std::vector<bool> edge_added = {true, false, true, false, false, true};
+  for (size_t idx = 0; idx < edge_ret.size(); idx++) {
+    ASSERT_EQ(edge_ret[idx].second, edge_added[idx]);
+  }
+  ASSERT_FALSE(edge_ret[1].first);
+  ASSERT_EQ(edge_ret[3].first, g.FindEdge(10));
+  ASSERT_EQ(edge_ret[4].first, edge_ret[0].first);
+  ASSERT_EQ(g.CountEdge(), 4);
+  ASSERT_EQ(g.FindEdge(14)->src_handle()->id(), 5);
+  ASSERT_EQ(g.FindEdge(14)->dst_handle()->id(), 1);
+  ASSERT_EQ(g.FindVertex(3)->CountOutEdge(), 1);
+  ASSERT_EQ(g.FindVertex(3)->CountInEdge(), 1);
+  return;
+}
+
+TEST(TestGUNDAM, AddBatch) {
+  using namespace GUNDAM;
+
+  using LG = LargeGraph<uint64_t, uint32_t, std::string,
+                        uint64_t, uint32_t, std::string>;
+
+  using LG2 = LargeGraph2<uint64_t, uint32_t, std::string,
+                          uint64_t, uint32_t, std::string>;
+
+  TestAddBatch<LG>();
+  TestAddBatch<LG2>();
+}
+
+template <class GraphType>
+void CheckSameAdjacency(GraphType& g1, GraphType& g2) {
+  ASSERT_EQ(g1.CountVertex(), g2.CountVertex());
+  ASSERT_EQ(g1.CountEdge(),   g2.CountEdge());
+  for (auto vertex_it = g1.VertexBegin(); !vertex_it.IsDone(); vertex_it++) {
+    auto vertex_handle = g2.FindVertex(vertex_it->id());
+    ASSERT_TRUE(vertex_handle);
+    ASSERT_EQ(vertex_handle->CountOutEdge(), vertex_it->CountOutEdge());
+    ASSERT_EQ(vertex_handle->CountInEdge(),  vertex_it->CountInEdge());
+    ASSERT_EQ(vertex_handle->CountOutVertex(), vertex_it->CountOutVertex());
+    ASSERT_EQ(vertex_handle->CountInVertex(),  vertex_it->CountInVertex());
+    for (uint32_t edge_label = 0; edge_label < 3; edge_label++) {
+      ASSERT_EQ(vertex_handle->CountOutEdge(edge_label),
+                vertex_it    ->CountOutEdge(edge_label));
+      ASSERT_EQ(vertex_handle->CountInEdge(edge_label),
+                vertex_it    ->CountInEdge(edge_label));
+      ASSERT_EQ(vertex_handle->CountOutVertex(edge_label),
+                vertex_it    ->CountOutVertex(edge_label));
+      ASSERT_EQ(vertex_handle->CountInVertex(edge_label),
+                vertex_it    ->CountInVertex(edge_label));
+      std::set<uint64_t> edge_id_set;
+      for (auto edge_it = vertex_it->OutEdgeBegin(edge_label);
+               !edge_it.IsDone(); edge_it++) {
+        edge_id_set.emplace(edge_it->id());
+        ASSERT_EQ(vertex_handle->CountOutEdge(edge_label,
+                      g2.FindVertex(edge_it->dst_handle()->id())),
+                  vertex_it    ->CountOutEdge(edge_label,
+                      edge_it->dst_handle()));
+      }
+      for (auto edge_it = vertex_handle->OutEdgeBegin(edge_label);
+               !edge_it.IsDone(); edge_it++) {
+        ASSERT_EQ(edge_id_set.erase(edge_it->id()), 1);
+      }
+      ASSERT_TRUE(edge_id_set.empty());
+    }
+  }
+  return;
+}
+
+template <class GraphType>
+void TestBulkLoad() {
+  const int kVertexNum = 200,
+            kEdgeNum   = 5000;
+  std::mt19937 gen(20211018);
+  // most edges are adjacent to a few hub vertexes
+  auto random_vertex = [&gen]() -> uint64_t {
+    return gen() % 4 == 0 ? gen() % kVertexNum + 1 : gen() % 5 + 1;
+  };
+  std::vector<std::tuple<uint64_t, uint64_t, uint32_t, uint64_t>> edges;
+  for (uint64_t edge_id = 1; edge_id <= kEdgeNum; edge_id++) {
+    edges.emplace_back(random_vertex(), random_vertex(), gen() % 3, edge_id);
+  }
+
+  GraphType g1, g2;
+  for (uint64_t vertex_id = 1; vertex_id <= kVertexNum; vertex_id++) {
+    ASSERT_TRUE(g1.AddVertex(vertex_id, vertex_id % 3).second);
+    ASSERT_TRUE(g2.AddVertex(vertex_id, vertex_id % 3).second);
+  }
+  for (const auto& [src_id, dst_id, label_id, edge_id] : edges) {
+    ASSERT_TRUE(g1.AddEdge(src_id, dst_id, label_id, edge_id).second);
+  }
+  ASSERT_TRUE(g1.EraseEdge(kEdgeNum / 2));
+
+  // the edges linked before the bulk load are merged with the new ones
+  for (size_t idx = 0; idx < kEdgeNum / 4; idx++) {
+    const auto& [src_id, dst_id, label_id, edge_id] = edges[idx];
+    ASSERT_TRUE(g2.AddEdge(src_id, dst_id, label_id, edge_id).second);
+  }
+  g2.BeginBulkLoad();
+  ASSERT_TRUE(g2.IsBulkLoading());
+  for (size_t idx = kEdgeNum / 4; idx < kEdgeNum / 2; idx++) {
+    const auto& [src_id, dst_id, label_id, edge_id] = edges[idx];
+    ASSERT_TRUE(g2.AddEdge(src_id, dst_id, label_id, edge_id).second);
+  }
+  // indexed by id but not linked yet
+  ASSERT_EQ(g2.CountEdge(), kEdgeNum / 2);
+  size_t linked_out_edge_count = 0;
+  for (size_t idx = 0; idx < kEdgeNum / 4; idx++) {
+    if (std::get<0>(edges[idx]) == 1) {
+      linked_out_edge_count++;
+    }
+  }
+  ASSERT_EQ(g2.FindVertex(1)->CountOutEdge(), linked_out_edge_count);
+  // erasing links the edges added so far
+  ASSERT_TRUE(g2.EraseEdge(kEdgeNum / 2));
+  ASSERT_TRUE(g2.IsBulkLoading());
+  std::vector<std::tuple<uint64_t, uint64_t, uint32_t, uint64_t>> batch(
+      edges.begin() + kEdgeNum / 2, edges.end());
+  auto ret = g2.AddEdgeBatch(batch);
+  for (const auto& [edge_handle, r] : ret) {
+    ASSERT_TRUE(r);
+  }
+  ASSERT_FALSE(g2.AddEdge(1, 2, 0, kEdgeNum).second);
+  g2.EndBulkLoad();
+  ASSERT_FALSE(g2.IsBulkLoading());
+
+  CheckSameAdjacency(g1, g2);
+  CheckSameAdjacency(g2, g1);
+  return;
+}
+
+TEST(TestGUNDAM, BulkLoad) {
+  using namespace GUNDAM;
+
+  using LG = LargeGraph<uint64_t, uint32_t, std::string,
+                        uint64_t, uint32_t, std::string>;
+
+  using LG2 = LargeGraph2<uint64_t, uint32_t, std::string,
+                          uint64_t, uint32_t, std::string>;
+
+  TestBulkLoad<LG>();
+  TestBulkLoad<LG2>();
+}
+
+TEST(TestGUNDAM, ReadCSVGraphParallel) {
+  using namespace GUNDAM;
+
+  using G1 = Graph<SetVertexIDType<uint64_t>,
+                   SetVertexLabelType<uint32_t>,
+                   SetVertexAttributeKeyType<std::string>,
+                   SetEdgeIDType<uint64_t>,
+                   SetEdgeLabelType<uint32_t>,
+                   SetEdgeAttributeKeyType<std::string>>;
+
+  using LG = LargeGraph<uint64_t, uint32_t, std::string,
+                        uint64_t, uint32_t, std::string>;
+
+  using LG2 = LargeGraph2<uint64_t, uint32_t, std::string,
+                          uint64_t, uint32_t, std::string>;
+
+  TestReadCSVGraphParallel<G1>();
+  TestReadCSVGraphParallel<LG>();
+  TestReadCSVGraphParallel<LG2>();
+
+  TestReadCSVGraphParallelFormat<G1>();
+  TestReadCSVGraphParallelFormat<LG>();
+}
@@ -0,0 +1,172 @@
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gundam/algorithm/dp_iso.h"
+#include "gundam/algorithm/dp_iso_parallel.h"
+#include "gundam/graph_type/graph.h"
+#include "gundam/graph_type/large_graph.h"
+#include "gundam/graph_type/large_graph2.h"
+#include "gundam/type_getter/vertex_handle.h"
+
+template <class GraphType>
+void BuildRandomTargetGraph(GraphType& target, int vertex_num, int edge_num,
+                            int vertex_label_num, int edge_label_num) {
+  std::mt19937 gen(20211018);
+  for (int vertex_id = 1; vertex_id <= vertex_num; vertex_id++) {
+    ASSERT_TRUE(target.AddVertex(vertex_id, gen() % vertex_label_num).second);
+  }
+  for (int edge_id = 1; edge_id <= edge_num; edge_id++) {
+    int src_id = gen() % vertex_num + 1,
+        dst_id = gen() % vertex_num + 1;
+    ASSERT_TRUE(target.AddEdge(src_id, dst_id, gen() % edge_label_num,
+                               edge_id).second);
+  }
+  return;
+}
+
+template <class QueryGraph, class TargetGraph>
+void TestDPISOParallel(QueryGraph& query, TargetGraph& target) {
+  using namespace GUNDAM;
+
+  using QueryVertexHandle = typename VertexHandle<QueryGraph>::type;
+  using TargetVertexHandle = typename VertexHandle<TargetGraph>::type;
+
+  using MatchKey = std::vector<std::pair<uint64_t, uint64_t>>;
+
+  auto to_key = [](const std::map<QueryVertexHandle,
+                                  TargetVertexHandle>& match_state) {
+    MatchKey key;
+    for (const auto& [query_handle, target_handle] : match_state) {
+      key.emplace_back(query_handle->id(), target_handle->id());
+    }
+    return key;
+  };
+
+  std::multiset<MatchKey> serial_result;
+  int serial_count = DPISO<MatchSemantics::kIsomorphism>(
+      query, target, [&serial_result, &to_key](auto& match_state) {
+        serial_result.emplace(to_key(match_state));
+        return true;
+      });
+  ASSERT_EQ(serial_count, serial_result.size());
+
+  for (int thread_num : {1, 2, 4, 8}) {
+    std::multiset<MatchKey> parallel_result;
+    int parallel_count = DPISO_Parallel<MatchSemantics::kIsomorphism>(
+        query, target,
+        [&parallel_result, &to_key](auto& match_state) {
+          parallel_result.emplace(to_key(match_state));
+          return true;
+        },
+        thread_num);
+    ASSERT_EQ(parallel_count, serial_count);
+    ASSERT_TRUE(parallel_result == serial_result);
+  }
+
+  if (serial_count < 3) {
+    return;
+  }
+  // the user callback should not be called after it returns false
+  for (int thread_num : {1, 4}) {
+    int callback_count = 0;
+    int parallel_count = DPISO_Parallel<MatchSemantics::kIsomorphism>(
+        query, target,
+        [&callback_count](auto& match_state) {
+          callback_count++;
+          return callback_count < 3;
+        },
+        thread_num);
+    ASSERT_EQ(callback_count, 3);
+    ASSERT_EQ(parallel_count, 3);
+  }
+
+  // prune all branches that match the first query vertex
+  // to a target vertex with odd id
+  const QueryVertexHandle kFirstQueryHandle = query.VertexBegin();
+  std::multiset<MatchKey> serial_prune_result;
+  auto prune_callback = [&kFirstQueryHandle](auto& match_state) {
+    auto it = match_state.find(kFirstQueryHandle);
+    return it != match_state.end() && it->second->id() % 2 == 1;
+  };
+  DPISO<MatchSemantics::kIsomorphism>(
+      query, target,
+      [&serial_prune_result, &to_key](auto& match_state) {
+        serial_prune_result.emplace(to_key(match_state));
+        return true;
+      },
+      prune_callback, nullptr);
+  for (int thread_num : {1, 4}) {
+    std::multiset<MatchKey> parallel_prune_result;
+    DPISO_Parallel<MatchSemantics::kIsomorphism>(
+        query, target,
+        [&parallel_prune_result, &to_key](auto& match_state) {
+          parallel_prune_result.emplace(to_key(match_state));
+          return true;
+        },
+        prune_callback, nullptr, thread_num);
+    ASSERT_TRUE(parallel_prune_result == serial_prune_result);
+  }
+  return;
+}
+
+template <class QueryGraph, class TargetGraph>
+void TestDPISOParallel1() {
+  TargetGraph target;
+  BuildRandomTargetGraph(target, 300, 3000, 3, 2);
+
+  // path
+  QueryGraph query1;
+  ASSERT_TRUE(query1.AddVertex(1, 0).second);
+  ASSERT_TRUE(query1.AddVertex(2, 1).second);
+  ASSERT_TRUE(query1.AddVertex(3, 2).second);
+  ASSERT_TRUE(query1.AddEdge(1, 2, 0, 1).second);
+  ASSERT_TRUE(query1.AddEdge(2, 3, 1, 2).second);
+  TestDPISOParallel(query1, target);
+
+  // triangle
+  QueryGraph query2;
+  ASSERT_TRUE(query2.AddVertex(1, 0).second);
+  ASSERT_TRUE(query2.AddVertex(2, 0).second);
+  ASSERT_TRUE(query2.AddVertex(3, 1).second);
+  ASSERT_TRUE(query2.AddEdge(1, 2, 0, 1).second);
+  ASSERT_TRUE(query2.AddEdge(2, 3, 0, 2).second);
+  ASSERT_TRUE(query2.AddEdge(3, 1, 1, 3).second);
+  TestDPISOParallel(query2, target);
+
+  // star with two vertexes of the same label
+  QueryGraph query3;
+  ASSERT_TRUE(query3.AddVertex(1, 1).second);
+  ASSERT_TRUE(query3.AddVertex(2, 0).second);
+  ASSERT_TRUE(query3.AddVertex(3, 0).second);
+  ASSERT_TRUE(query3.AddVertex(4, 2).second);
+  ASSERT_TRUE(query3.AddEdge(1, 2, 0, 1).second);
+  ASSERT_TRUE(query3.AddEdge(1, 3, 0, 2).second);
+  ASSERT_TRUE(query3.AddEdge(4, 1, 1, 3).second);
+  TestDPISOParallel(query3, target);
+  return;
+}
+
+TEST(TestGUNDAM, DPISO_Parallel) {
+  using namespace GUNDAM;
+
+  using G1 = Graph<SetVertexIDType<uint32_t>,
+                   SetVertexLabelType<uint32_t>,
+                   SetEdgeIDType<uint32_t>,
+                   SetEdgeLabelType<uint32_t>>;
+
+  using LG = LargeGraph<uint64_t, uint32_t, std::string,
+                        uint64_t, uint32_t, std::string>;
+
+  using LG2 = LargeGraph2<uint64_t, uint32_t, std::string,
+                          uint64_t, uint32_t, std::string>;
+
+  TestDPISOParallel1<G1, G1>();
+  TestDPISOParallel1<G1, LG>();
+  TestDPISOParallel1<LG, LG>();
+  TestDPISOParallel1<LG, LG2>();
+}
@@ -0,0 +1,305 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "gundam/io/graph_snapshot.h"
+
+#include "gundam/graph_type/csr_graph.h"
+#include "gundam/graph_type/graph.h"
+#include "gundam/graph_type/large_graph.h"
+#include "gundam/graph_type/large_graph2.h"
+
+#include "gundam/type_getter/vertex_handle.h"
+#include "gundam/type_getter/edge_handle.h"
+
+template <class GraphType>
+void BuildSnapshotTestGraph(GraphType& g) {
+  std::mt19937 gen(20211018);
+  const int kVertexNum = 200,
+              kEdgeNum = 1000;
+  for (int vertex_id = 1; vertex_id <= kVertexNum; vertex_id++) {
+    auto [vertex_handle, ret] = g.AddVertex(vertex_id, gen() % 3);
+    ASSERT_TRUE(ret);
+    if (vertex_id % 2 == 0) {
+      ASSERT_TRUE(vertex_handle->AddAttribute(
+          std::string("name"), "v" + std::to_string(vertex_id)).second);
+    }
+    if (vertex_id % 3 == 0) {
+      ASSERT_TRUE(vertex_handle->AddAttribute(
+          std::string("age"), (int)(vertex_id * 7)).second);
+    }
+    ASSERT_TRUE(vertex_handle->AddAttribute(
+        std::string("score"), vertex_id * 0.5).second);
+    if (vertex_id % 5 == 0) {
+      ASSERT_TRUE(vertex_handle->AddAttribute(
+          std::string("time"),
+          GUNDAM::DateTime((time_t)(1600000000 + vertex_id))).second);
+    }
+  }
+  for (int edge_id = 1; edge_id <= kEdgeNum; edge_id++) {
+    int src_id = gen() % kVertexNum + 1,
+        dst_id = gen() % kVertexNum + 1;
+    auto [edge_handle, ret] = g.AddEdge(src_id, dst_id, gen() % 2, edge_id);
+    ASSERT_TRUE(ret);
+    if (edge_id % 4 == 0) {
+      ASSERT_TRUE(edge_handle->AddAttribute(
+          std::string("weight"), (int64_t)edge_id * 1000000007).second);
+    }
+  }
+  return;
+}
+
+template <class GraphType, class OtherGraphType>
+void CheckSameGraph(GraphType& graph, OtherGraphType& other_graph) {
+  ASSERT_EQ(graph.CountVertex(), other_graph.CountVertex());
+  ASSERT_EQ(graph.CountEdge(),   other_graph.CountEdge());
+  for (auto vertex_it = graph.VertexBegin();
+           !vertex_it.IsDone();
+            vertex_it++) {
+    typename GUNDAM::VertexHandle<GraphType>::type
+        vertex_handle = vertex_it;
+    typename GUNDAM::VertexHandle<OtherGraphType>::type
+        other_vertex_handle = other_graph.FindVertex(vertex_it->id());
+    ASSERT_TRUE(other_vertex_handle);
+    ASSERT_EQ(vertex_handle->label(), other_vertex_handle->label());
+    ASSERT_EQ(vertex_handle->CountOutEdge(),
+              other_vertex_handle->CountOutEdge());
+    ASSERT_EQ(vertex_handle->CountInEdge(),
+              other_vertex_handle->CountInEdge());
+    size_t attr_count = 0;
+    for (auto attr_it = vertex_handle->AttributeBegin();
+             !attr_it.IsDone();
+              attr_it++) {
+      auto other_attr_handle
+         = other_vertex_handle->FindAttribute(attr_it->key());
+      ASSERT_TRUE(other_attr_handle);
+      ASSERT_EQ(attr_it->value_type(), other_attr_handle->value_type());
+      ASSERT_EQ(attr_it->value_str(),  other_attr_handle->value_str());
+      attr_count++;
+    }
+    for (auto attr_it = other_vertex_handle->AttributeBegin();
+             !attr_it.IsDone();
+              attr_it++) {
+      attr_count--;
+    }
+    ASSERT_EQ(attr_count, 0);
+    for (auto edge_it = vertex_handle->OutEdgeBegin();
+             !edge_it.IsDone();
+              edge_it++) {
+      auto other_edge_handle = other_graph.FindEdge(edge_it->id());
+      ASSERT_TRUE(other_edge_handle);
+      ASSERT_EQ(edge_it->label(), other_edge_handle->label());
+      ASSERT_EQ(edge_it->src_handle()->id(),
+                other_edge_handle->src_handle()->id());
+      ASSERT_EQ(edge_it->dst_handle()->id(),
+                other_edge_handle->dst_handle()->id());
+      auto attr_handle = edge_it->FindAttribute(std::string("weight"));
+      auto other_attr_handle
+         = other_edge_handle->FindAttribute(std::string("weight"));
+      ASSERT_EQ((bool)attr_handle, (bool)other_attr_handle);
+      if (attr_handle) {
+        ASSERT_EQ(attr_handle->template const_value<int64_t>(),
+                  other_attr_handle->template const_value<int64_t>());
+      }
+    }
+  }
+  return;
+}
+
+template <class SrcGraphType, class DstGraphType>
+void TestGraphSnapshot() {
+  using namespace GUNDAM;
+
+  const std::string kSnapshotFile = "test_graph_snapshot.bin";
+
+  SrcGraphType src_graph;
+  BuildSnapshotTestGraph(src_graph);
+
+  int res = WriteGraphSnapshot(src_graph, kSnapshotFile);
+  ASSERT_EQ(res, src_graph.CountVertex() + src_graph.CountEdge());
+
+  // served from the mapping
+  GraphSnapshotOf<DstGraphType> snapshot;
+  ASSERT_EQ(snapshot.Open(kSnapshotFile), 0);
+  ASSERT_EQ(snapshot.CountVertex(), src_graph.CountVertex());
+  ASSERT_EQ(snapshot.CountEdge(),   src_graph.CountEdge());
+  ASSERT_EQ(snapshot.vertex_columns().size(), 4);
+  ASSERT_EQ(snapshot.edge_columns().size(),   1);
+
+  const auto* name_column = snapshot.FindVertexColumn("name");
+  const auto*  age_column = snapshot.FindVertexColumn("age");
+  const auto* time_column = snapshot.FindVertexColumn("time");
+  ASSERT_TRUE(name_column && age_column && time_column);
+  ASSERT_FALSE(snapshot.FindVertexColumn("not_exist"));
+  ASSERT_EQ(name_column->value_type(), BasicDataType::kTypeString);
+  ASSERT_EQ( age_column->value_type(), BasicDataType::kTypeInt);
+  ASSERT_EQ(time_column->value_type(), BasicDataType::kTypeDateTime);
+  for (size_t i = 0; i < snapshot.CountVertex(); i++) {
+    const auto kVertexID = snapshot.vertex_id()[i];
+    ASSERT_EQ(snapshot.FindVertex(kVertexID), i);
+    auto src_vertex_handle = src_graph.FindVertex(kVertexID);
+    ASSERT_TRUE(src_vertex_handle);
+    ASSERT_EQ(snapshot.vertex_label()[i], src_vertex_handle->label());
+    if (i > 0) {
+      ASSERT_TRUE(snapshot.vertex_label()[i - 1] < snapshot.vertex_label()[i]
+              || (snapshot.vertex_label()[i - 1] == snapshot.vertex_label()[i]
+               && snapshot.vertex_id()[i - 1] < snapshot.vertex_id()[i]));
+    }
+    ASSERT_EQ(name_column->IsNull(i), kVertexID % 2 != 0);
+    if (!name_column->IsNull(i)) {
+      ASSERT_EQ(name_column->string_value(i),
+                "v" + std::to_string(kVertexID));
+    }
+    ASSERT_EQ(age_column->IsNull(i), kVertexID % 3 != 0);
+    if (!age_column->IsNull(i)) {
+      ASSERT_EQ(age_column->template value<int>(i), kVertexID * 7);
+    }
+    ASSERT_EQ(time_column->IsNull(i), kVertexID % 5 != 0);
+    if (!time_column->IsNull(i)) {
+      ASSERT_EQ(time_column->template value<DateTime>(i),
+                DateTime((time_t)(1600000000 + kVertexID)));
+    }
+    ASSERT_EQ(snapshot.out_offset()[i + 1] - snapshot.out_offset()[i],
+              src_vertex_handle->CountOutEdge());
+    ASSERT_EQ(snapshot.in_offset()[i + 1] - snapshot.in_offset()[i],
+              src_vertex_handle->CountInEdge());
+    for (size_t j = snapshot.out_offset()[i];
+                j < snapshot.out_offset()[i + 1]; j++) {
+      ASSERT_EQ(snapshot.edge_src()[j], i);
+    }
+    for (size_t j = snapshot.in_offset()[i];
+                j < snapshot.in_offset()[i + 1]; j++) {
+      ASSERT_EQ(snapshot.edge_dst()[snapshot.in_edge()[j]], i);
+    }
+  }
+  ASSERT_EQ(snapshot.FindVertex(0), snapshot.kNoIndex);
+  for (size_t i = 0; i < snapshot.CountEdge(); i++) {
+    ASSERT_EQ(snapshot.FindEdge(snapshot.edge_id()[i]), i);
+  }
+
+  // loaded into a graph
+  DstGraphType dst_graph;
+  res = ReadGraphSnapshot(dst_graph, snapshot);
+  ASSERT_EQ(res, src_graph.CountVertex() + src_graph.CountEdge());
+  CheckSameGraph(src_graph, dst_graph);
+  CheckSameGraph(dst_graph, src_graph);
+
+  snapshot.Close();
+  ASSERT_FALSE(snapshot.IsOpen());
+
+  DstGraphType dst_graph2;
+  res = ReadGraphSnapshot(dst_graph2, kSnapshotFile);
+  ASSERT_EQ(res, src_graph.CountVertex() + src_graph.CountEdge());
+  CheckSameGraph(src_graph, dst_graph2);
+
+  std::remove(kSnapshotFile.c_str());
+  return;
+}
+
+std::string ReadWholeFile(const std::string& file) {
+  std::ifstream in(file, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in),
+                     std::istreambuf_iterator<char>());
+}
+
+// the snapshot is in the order held in CSRGraph, the same
+// file should be written from it
+template <class GraphType, class CSRGraphType>
+void TestGraphSnapshotFromCSRGraph() {
+  using namespace GUNDAM;
+
+  const std::string kSnapshotFile    = "test_graph_snapshot.bin",
+                    kCSRSnapshotFile = "test_graph_snapshot_csr.bin";
+
+  GraphType graph;
+  BuildSnapshotTestGraph(graph);
+  CSRGraphType csr_graph(graph);
+
+  ASSERT_GT(WriteGraphSnapshot(graph, kSnapshotFile), 0);
+  ASSERT_GT(WriteGraphSnapshot(csr_graph, kCSRSnapshotFile), 0);
+  ASSERT_TRUE(ReadWholeFile(kSnapshotFile)
+           == ReadWholeFile(kCSRSnapshotFile));
+
+  CSRGraphType csr_graph2;
+  ASSERT_GT(ReadGraphSnapshot(csr_graph2, kCSRSnapshotFile), 0);
+  CheckSameGraph(csr_graph, csr_graph2);
+  CheckSameGraph(csr_graph2, graph);
+
+  std::remove(kSnapshotFile.c_str());
+  std::remove(kCSRSnapshotFile.c_str());
+  return;
+}
+
+template <class GraphType>
+void TestGraphSnapshotError() {
+  using namespace GUNDAM;
+
+  const std::string kSnapshotFile = "test_graph_snapshot_error.bin";
+
+  GraphType graph;
+  BuildSnapshotTestGraph(graph);
+  ASSERT_GT(WriteGraphSnapshot(graph, kSnapshotFile), 0);
+
+  GraphSnapshotOf<GraphType> snapshot;
+  ASSERT_EQ(snapshot.Open("not_exist.bin"), -1);
+
+  // the id type is not the same
+  GraphSnapshot<uint32_t, uint32_t, uint64_t, uint32_t> other_snapshot;
+  ASSERT_EQ(other_snapshot.Open(kSnapshotFile), -3);
+
+  const std::string content = ReadWholeFile(kSnapshotFile);
+  // truncated
+  {
+    std::ofstream out(kSnapshotFile, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size() / 2);
+  }
+  ASSERT_EQ(snapshot.Open(kSnapshotFile), -4);
+  // not a snapshot
+  {
+    std::string broken_content = content;
+    broken_content[0] = 'X';
+    std::ofstream out(kSnapshotFile, std::ios::binary | std::ios::trunc);
+    out.write(broken_content.data(), broken_content.size());
+  }
+  ASSERT_EQ(snapshot.Open(kSnapshotFile), -2);
+  ASSERT_FALSE(snapshot.IsOpen());
+
+  std::remove(kSnapshotFile.c_str());
+  return;
+}
+
+TEST(TestGUNDAM, TestGraphSnapshot) {
+  using namespace GUNDAM;
+
+  using G1 = Graph<SetVertexIDType<uint64_t>,
+                   SetVertexLabelType<uint32_t>,
+                   SetVertexAttributeKeyType<std::string>,
+                   SetEdgeIDType<uint64_t>,
+                   SetEdgeLabelType<uint32_t>,
+                   SetEdgeAttributeKeyType<std::string>>;
+
+  using LG = LargeGraph<uint64_t, uint32_t, std::string,
+                        uint64_t, uint32_t, std::string>;
+
+  using LG2 = LargeGraph2<uint64_t, uint32_t, std::string,
+                          uint64_t, uint32_t, std::string>;
+
+  using CSRG = CSRGraph<uint64_t, uint32_t, std::string,
+                        uint64_t, uint32_t, std::string>;
+
+  TestGraphSnapshot<LG, LG>();
+  TestGraphSnapshot<LG, LG2>();
+  TestGraphSnapshot<LG, G1>();
+  TestGraphSnapshot<G1, LG>();
+  TestGraphSnapshot<LG, CSRG>();
+
+  TestGraphSnapshotFromCSRGraph<LG, CSRG>();
+
+  TestGraphSnapshotError<LG>();
+}